@@ -0,0 +1,184 @@
+/**
+# log-conform-kernel.c
+
+Microbenchmark for the per-cell cost of the log-conformation update in
+`src-local/log-conform-viscoelastic-scalar-2D.h`.
+
+## Purpose
+
+Time `log_conform_reference()` and `log_conform_fused()` on the same
+randomized, uniformly refined axisymmetric state and report the cost per
+cell and per call. The maximum difference between the conformation fields
+produced by the two kernels is printed as a consistency check.
+
+The per-cell `diagonalization_2D()` is also compared with the batched
+structure-of-arrays `diagonalization_2D_batch()` on the same tensors.
+
+Built with `-DCONFORM_BAND=N`, the fused kernel runs on the cached elastic
+band, and the `band_rebuild` row times one rebuild of the band
+(`conform_band_update()`). Its ratio to the fused row is the cost of a
+rebuild in fused steps: rebuilding at every step, as the band did before it
+was cached, adds that fraction to every step.
+
+## Output Columns
+
+`kernel level cells repeats ns_per_cell max_diff`
+
+## Build Example
+
+Add `-march=native` (and `-fopenmp` for `#pragma omp simd`) to let the
+batched diagonalization use the widest vector unit of the host.
+
+```bash
+qcc -O2 -Wall -disable-dimensions -I../src-local log-conform-kernel.c \
+  -o log-conform-kernel -lm
+./log-conform-kernel 10 20
+```
+*/
+
+#include "axi.h"
+#include "navier-stokes/centered.h"
+#include "log-conform-viscoelastic-scalar-2D.h"
+
+scalar B11[], B12[], B22[], BThTh[];
+
+/**
+### fill_state()
+
+Fills a reproducible, symmetric positive-definite conformation field and a
+random velocity field. The same `seed` always yields the same state.
+*/
+static void fill_state (unsigned int seed)
+{
+  srand (seed);
+  foreach (serial) {
+    A11[] = 1. + 2.*fabs(noise());
+    A22[] = 1. + 2.*fabs(noise());
+    A12[] = 0.9*noise()*sqrt(A11[]*A22[]);
+    AThTh[] = 1. + fabs(noise());
+    foreach_dimension()
+      u.x[] = noise();
+  }
+  foreach_face()
+    uf.x[] = fm.x[]*(u.x[] + u.x[-1])/2.;
+}
+
+/**
+### time_kernel()
+
+Runs `kernel` `repeats` times from the seeded state and returns the wall
+time per cell in nanoseconds.
+*/
+static double time_kernel (void (* kernel) (void), int repeats, long cells)
+{
+  fill_state (1);
+  timer start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    kernel();
+  return 1e9*timer_elapsed (start)/((double) repeats*cells);
+}
+
+/**
+### time_diagonalization()
+
+Times `diagonalization_2D()` cell by cell and `diagonalization_2D_batch()`
+on structure-of-arrays copies of the conformation field. Returns the
+maximum eigenvalue difference between both in `max_diff`.
+*/
+static void time_diagonalization (int repeats, long cells,
+                                  double * t_scalar, double * t_batch,
+                                  double * max_diff)
+{
+  fill_state (1);
+  double * lanes = malloc (9*cells*sizeof(double));
+  double * a11 = lanes, * a12 = lanes + cells, * a22 = lanes + 2*cells;
+  double * l1 = lanes + 3*cells, * l2 = lanes + 4*cells;
+  double * rxx = lanes + 5*cells, * rxy = lanes + 6*cells;
+  double * ryx = lanes + 7*cells, * ryy = lanes + 8*cells;
+  long k = 0;
+  foreach (serial) {
+    a11[k] = A11[]; a12[k] = A12[]; a22[k] = A22[];
+    k++;
+  }
+
+  timer start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    for (k = 0; k < cells; k++) {
+      pseudo_t A = {{a11[k], a12[k]}, {a12[k], a22[k]}}, R;
+      pseudo_v Lambda;
+      diagonalization_2D (&Lambda, &R, &A);
+      l1[k] = Lambda.x; l2[k] = Lambda.y;
+    }
+  *t_scalar = 1e9*timer_elapsed (start)/((double) repeats*cells);
+
+  double * ref = malloc (2*cells*sizeof(double));
+  memcpy (ref, l1, 2*cells*sizeof(double));
+
+  start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    diagonalization_2D_batch (cells, a11, a12, a22, l1, l2, rxx, rxy, ryx, ryy);
+  *t_batch = 1e9*timer_elapsed (start)/((double) repeats*cells);
+
+  *max_diff = 0.;
+  for (k = 0; k < 2*cells; k++)
+    *max_diff = max (*max_diff, fabs(ref[k] - l1[k]));
+
+  free (ref);
+  free (lanes);
+}
+
+int main (int argc, char const * argv[])
+{
+  int level = argc > 1 ? atoi (argv[1]) : 10;
+  int repeats = argc > 2 ? atoi (argv[2]) : 20;
+  if (level <= 0 || repeats <= 0) {
+    fprintf (ferr, "Usage: %s [level] [repeats]\n", argv[0]);
+    return 1;
+  }
+
+  L0 = 4*pi;
+  init_grid (1 << level);
+  dt = 1e-4;
+
+  long cells = 0;
+  foreach (reduction(+:cells))
+    cells++;
+
+  /**
+  One step of each kernel from the same state to compare the results. */
+
+  fill_state (1);
+  log_conform_reference();
+  foreach() {
+    B11[] = A11[]; B12[] = A12[]; B22[] = A22[]; BThTh[] = AThTh[];
+  }
+  fill_state (1);
+  log_conform_fused();
+  double max_diff = 0.;
+  foreach (reduction(max:max_diff)) {
+    double d = max (max (fabs(A11[] - B11[]), fabs(A12[] - B12[])),
+                    max (fabs(A22[] - B22[]), fabs(AThTh[] - BThTh[])));
+    if (d > max_diff)
+      max_diff = d;
+  }
+
+  double t_ref = time_kernel (log_conform_reference, repeats, cells);
+  double t_fused = time_kernel (log_conform_fused, repeats, cells);
+  double t_diag, t_batch, diag_diff;
+  time_diagonalization (repeats, cells, &t_diag, &t_batch, &diag_diff);
+
+  printf ("kernel level cells repeats ns_per_cell max_diff\n");
+  printf ("reference %d %ld %d %.3f %g\n", level, cells, repeats, t_ref, 0.);
+  printf ("fused %d %ld %d %.3f %g\n", level, cells, repeats, t_fused, max_diff);
+  printf ("diagonalization %d %ld %d %.3f %g\n", level, cells, repeats, t_diag, 0.);
+  printf ("diagonalization_batch %d %ld %d %.3f %g\n", level, cells, repeats, t_batch, diag_diff);
+  printf ("# speedup fused %.3f batch %.3f\n", t_ref/t_fused, t_diag/t_batch);
+#if CONFORM_BAND
+  double t_band = time_kernel (conform_band_update, repeats, cells);
+  printf ("band_rebuild %d %ld %d %.3f %g\n", level, cells, repeats, t_band, 0.);
+  printf ("# band rebuild / fused step %.3f\n", t_band/t_fused);
+#endif
+
+  free_grid();
+  return 0;
+}
@@ -0,0 +1,289 @@
+#!/bin/bash
+# run-benchmarks.sh
+#
+# Reproducible performance benchmarks for the simulation cases and their
+# hot kernels, compared against a baseline recorded earlier on the same
+# machine with --save-baseline. No baseline is shipped: timings only compare
+# on the hardware that produced them.
+#
+# Case benchmarks: short runs of LiquidInThinning.c and LiquidOutThinning.c
+# from the deterministic initial condition (no restart file, same
+# parameters every time), at each MAXlevel and OpenMP thread count. With
+# --restart, the same grid of runs also continues from a restart dump taken
+# near pinch-off, where the mesh is deepest. The cases are compiled once
+# each with -DPROFILE_EVENTS=1, whose profile provides the step and cell
+# counts (see src-local/event-profile.h).
+#
+# Microbenchmarks: benchmarks/log-conform-kernel.c (log-conformation
+# kernels and diagonalization_2D) and benchmarks/sampling-kernel.c (the
+# getData-elastic sampling loop).
+#
+# Results are written in long form, one metric per row:
+#   benchmark,metric,value
+# and compared with the baseline; a metric worse than the baseline by more
+# than --tolerance is reported as a regression (exit status 2).
+#
+# Usage:
+#   bash benchmarks/run-benchmarks.sh [--levels "10 12"] [--threads "1 4"]
+#                                     [--restart FILE --restart-tmax T]
+#                                     [--save-baseline]
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_DIR="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+usage() {
+  cat <<'EOF'
+Usage: bash benchmarks/run-benchmarks.sh [OPTIONS]
+
+Options:
+  --cases LIST       Case sources in simulationCases/
+                     (default: "LiquidInThinning.c LiquidOutThinning.c")
+  --params FILE      Base parameter file (default: default.params)
+  --levels LIST      MAXlevel values of the case runs (default: "10 12")
+  --micro-levels L   Levels of the microbenchmarks (default: "9 10")
+  --threads LIST     OpenMP thread counts (default: "1 4")
+  --tmax T           Simulated time of the fresh runs (default: 0.002)
+  --restart FILE     Restart dump near pinch-off; adds restart runs
+  --restart-tmax T   End time of the restart runs (required with --restart)
+  --no-cases         Skip the case benchmarks
+  --no-micro         Skip the microbenchmarks
+  --baseline FILE    Baseline CSV recorded with --save-baseline on this
+                     machine (default: benchmarks/baseline.csv)
+  --save-baseline    Record this run as the baseline instead of comparing
+  --tolerance PCT    Allowed slowdown before reporting a regression
+                     (default: 10)
+  --out FILE         Results CSV (default: benchmarks/results.csv)
+  -h, --help         Show this help message
+
+Metrics per case run: steps, cells, seconds, time_per_step,
+cells_per_second, peak_rss_kb, bytes_written. Microbenchmarks report
+ns_per_cell or ns_per_item.
+EOF
+}
+
+CASES="LiquidInThinning.c LiquidOutThinning.c"
+PARAM_FILE="${REPO_DIR}/default.params"
+LEVELS="10 12"
+MICRO_LEVELS="9 10"
+THREADS="1 4"
+TMAX=0.002
+RESTART_FILE=""
+RESTART_TMAX=""
+RUN_CASES=1
+RUN_MICRO=1
+BASELINE_FILE="${SCRIPT_DIR}/baseline.csv"
+SAVE_BASELINE=0
+TOLERANCE=10
+OUT_FILE="${SCRIPT_DIR}/results.csv"
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -h|--help) usage; exit 0 ;;
+    --cases) CASES="$2"; shift 2 ;;
+    --params) PARAM_FILE="$2"; shift 2 ;;
+    --levels) LEVELS="$2"; shift 2 ;;
+    --micro-levels) MICRO_LEVELS="$2"; shift 2 ;;
+    --threads) THREADS="$2"; shift 2 ;;
+    --tmax) TMAX="$2"; shift 2 ;;
+    --restart) RESTART_FILE="$2"; shift 2 ;;
+    --restart-tmax) RESTART_TMAX="$2"; shift 2 ;;
+    --no-cases) RUN_CASES=0; shift ;;
+    --no-micro) RUN_MICRO=0; shift ;;
+    --baseline) BASELINE_FILE="$2"; shift 2 ;;
+    --save-baseline) SAVE_BASELINE=1; shift ;;
+    --tolerance) TOLERANCE="$2"; shift 2 ;;
+    --out) OUT_FILE="$2"; shift 2 ;;
+    *)
+      echo "ERROR: Unknown argument: $1" >&2
+      usage
+      exit 1
+      ;;
+  esac
+done
+
+if [[ -n "$RESTART_FILE" ]]; then
+  if [[ ! -f "$RESTART_FILE" || -z "$RESTART_TMAX" ]]; then
+    echo "ERROR: --restart needs an existing dump and --restart-tmax." >&2
+    exit 1
+  fi
+  RESTART_FILE="$(cd "$(dirname "$RESTART_FILE")" && pwd)/$(basename "$RESTART_FILE")"
+fi
+
+if [[ -f "${REPO_DIR}/.project_config" ]]; then
+  # shellcheck disable=SC1091
+  source "${REPO_DIR}/.project_config"
+fi
+
+if ! command -v qcc >/dev/null 2>&1; then
+  echo "ERROR: qcc not found in PATH." >&2
+  exit 1
+fi
+
+# GNU time reports the peak resident set size; without it the metric is -1.
+TIME_TOOL=""
+if [[ -x /usr/bin/time ]] && /usr/bin/time -f %M true >/dev/null 2>&1; then
+  TIME_TOOL=/usr/bin/time
+fi
+
+WORK_DIR="${SCRIPT_DIR}/benchmark-runs"
+mkdir -p "$WORK_DIR"
+RESULTS="${WORK_DIR}/results.tmp"
+echo "benchmark,metric,value" > "$RESULTS"
+
+record() {
+  printf '%s,%s,%s\n' "$1" "$2" "$3" >> "$RESULTS"
+}
+
+build() {
+  local src="$1" exe="$2"
+  shift 2
+  echo "Compiling ${src##*/} ..."
+  (cd "$WORK_DIR" && qcc -I"${REPO_DIR}/src-local" -O2 -Wall -disable-dimensions \
+    "$@" "$src" -o "$exe" -lm)
+}
+
+# Runs "$@" in directory $1 and prints "seconds peak_rss_kb status".
+timed_run() {
+  local dir="$1"
+  shift
+  local start end rss=-1 status=0
+  start=$(date +%s.%N)
+  if [[ -n "$TIME_TOOL" ]]; then
+    (cd "$dir" && "$TIME_TOOL" -f %M -o rss.txt "$@" > run.out 2>&1) || status=$?
+    rss=$(tail -n 1 "${dir}/rss.txt")
+  else
+    (cd "$dir" && "$@" > run.out 2>&1) || status=$?
+  fi
+  end=$(date +%s.%N)
+  awk -v a="$start" -v b="$end" -v r="$rss" -v s="$status" \
+    'BEGIN { printf "%.3f %s %d\n", b - a, r, s }'
+}
+
+# Records the metrics of one case run from its profile and output files.
+#
+# Steps and cells come from the logWriting rows of the profile (one call
+# per step, cells summed over the steps); bytes_written is the size of
+# every file created or rewritten during the run.
+record_case() {
+  local name="$1" dir="$2" seconds="$3" rss="$4"
+  local steps cells bytes
+  read -r steps cells < <(awk -F, '$4 == "logWriting" { s += $6; c += $8 }
+    END { printf "%d %.0f\n", s, c }' "$dir"/c*-profile.csv 2>/dev/null || echo "0 0")
+  bytes=$(find "$dir" -type f -newer "${dir}/.stamp" ! -name run.out \
+    ! -name rss.txt ! -name 'c*-profile.csv' -printf '%s\n' | awk '{ s += $1 } END { print s + 0 }')
+  record "$name" steps "$steps"
+  record "$name" cells "$cells"
+  record "$name" seconds "$seconds"
+  if [[ "$steps" -gt 0 ]]; then
+    awk -v n="$name" -v s="$seconds" -v k="$steps" -v c="$cells" 'BEGIN {
+      printf "%s,time_per_step,%.6g\n", n, s/k
+      printf "%s,cells_per_second,%.6g\n", n, c/s
+    }' >> "$RESULTS"
+  fi
+  record "$name" peak_rss_kb "$rss"
+  record "$name" bytes_written "$bytes"
+}
+
+if [[ $RUN_CASES -eq 1 ]]; then
+  for src in $CASES; do
+    if [[ ! -f "${REPO_DIR}/simulationCases/${src}" ]]; then
+      echo "ERROR: simulationCases/${src} not found." >&2
+      exit 1
+    fi
+    exe="${WORK_DIR}/${src%.c}"
+    build "${REPO_DIR}/simulationCases/${src}" "$exe" -fopenmp -DPROFILE_EVENTS=1
+
+    scenarios="fresh"
+    [[ -n "$RESTART_FILE" ]] && scenarios="fresh restart"
+    for scenario in $scenarios; do
+      for level in $LEVELS; do
+        for threads in $THREADS; do
+          name="${src%.c}-${scenario}-L${level}-t${threads}"
+          run_dir="${WORK_DIR}/${name}"
+          rm -rf "$run_dir"
+          mkdir -p "$run_dir"
+          tmax="$TMAX"
+          if [[ "$scenario" == restart ]]; then
+            cp "$RESTART_FILE" "${run_dir}/restart"
+            tmax="$RESTART_TMAX"
+          fi
+          grep -v -E '^[[:space:]]*(MAXlevel|tmax|logEchoEvery|profileEvery|tframe)[[:space:]]*=' \
+            "$PARAM_FILE" > "${run_dir}/case.params"
+          printf 'MAXlevel=%s\ntmax=%s\nlogEchoEvery=0\nprofileEvery=1000000000\ntframe=0\n' \
+            "$level" "$tmax" >> "${run_dir}/case.params"
+          touch "${run_dir}/.stamp"
+
+          echo "Running ${name} ..."
+          read -r seconds rss status < <(timed_run "$run_dir" env OMP_NUM_THREADS="$threads" \
+            "$exe" case.params)
+          if [[ "$status" -ne 0 ]]; then
+            echo "ERROR: ${name} failed (exit ${status}), see ${run_dir}/run.out" >&2
+            exit 1
+          fi
+          record_case "$name" "$run_dir" "$seconds" "$rss"
+        done
+      done
+    done
+  done
+fi
+
+if [[ $RUN_MICRO -eq 1 ]]; then
+  build "${SCRIPT_DIR}/log-conform-kernel.c" "${WORK_DIR}/log-conform-kernel"
+  build "${SCRIPT_DIR}/sampling-kernel.c" "${WORK_DIR}/sampling-kernel"
+  for level in $MICRO_LEVELS; do
+    echo "Running microbenchmarks at level ${level} ..."
+    "${WORK_DIR}/log-conform-kernel" "$level" 20 | awk -v l="$level" '
+      $1 != "kernel" && $1 !~ /^#/ { printf "micro:%s-L%s,ns_per_cell,%s\n", $1, l, $5 }' \
+      >> "$RESULTS"
+    "${WORK_DIR}/sampling-kernel" "$level" 400 5 | awk -v l="$level" '
+      $1 != "kernel" && $1 !~ /^#/ { printf "micro:%s-L%s,ns_per_item,%s\n", $1, l, $6 }' \
+      >> "$RESULTS"
+  done
+fi
+
+mv "$RESULTS" "$OUT_FILE"
+echo "Benchmark results: ${OUT_FILE}"
+
+if [[ $SAVE_BASELINE -eq 1 ]]; then
+  cp "$OUT_FILE" "$BASELINE_FILE"
+  echo "Baseline saved: ${BASELINE_FILE}"
+  exit 0
+fi
+
+if [[ ! -f "$BASELINE_FILE" ]]; then
+  echo "No baseline at ${BASELINE_FILE}; rerun with --save-baseline to store one."
+  exit 0
+fi
+
+# The ratio is oriented so that > 1 is worse: higher is better for
+# cells_per_second, lower for the times, the memory and the bytes written.
+# Step and cell counts are printed for reference only.
+awk -F, -v tol="$TOLERANCE" '
+  FNR == 1 { next }
+  NR == FNR { base[$1 "," $2] = $3; next }
+  {
+    key = $1 "," $2
+    if (!(key in base) || base[key] <= 0 || $3 < 0)
+      next
+    if ($2 == "steps" || $2 == "cells")
+      ratio = $3/base[key]
+    else if ($2 == "cells_per_second")
+      ratio = base[key]/$3
+    else
+      ratio = $3/base[key]
+    flag = ""
+    if ($2 != "steps" && $2 != "cells" && ratio > 1 + tol/100) {
+      flag = "  REGRESSION"
+      regressions++
+    }
+    printf "%-48s %-18s %12.6g %12.6g %7.3f%s\n", $1, $2, base[key], $3, ratio, flag
+  }
+  BEGIN {
+    printf "%-48s %-18s %12s %12s %7s\n", "benchmark", "metric", "baseline", "current", "ratio"
+  }
+  END {
+    printf "%d regression(s) beyond %s%%\n", regressions, tol
+    exit regressions > 0 ? 2 : 0
+  }' "$BASELINE_FILE" "$OUT_FILE"
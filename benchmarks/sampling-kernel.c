@@ -0,0 +1,147 @@
+/**
+# sampling-kernel.c
+
+Microbenchmark for the sampling loop of `postProcess/getData-elastic.c`
+and `postProcess/getFrame-elastic.c`.
+
+## Purpose
+
+Build a reproducible adaptive tree refined to `level` around a thinning
+thread (the mesh a snapshot near pinch-off has), fill the fields from a
+fixed seed, and time:
+
+- `elastic_derived_fields()` (all of `D2c`, `vel`, `trA`);
+- `elastic_sample_window()`, the leaf walk used by the helpers;
+- `elastic_sample_window_located()`, the `interpolate()` reference.
+
+The maximum difference between both samplers is printed as a consistency
+check.
+
+## Output Columns
+
+`kernel level cells samples repeats ns_per_item max_diff`
+
+`ns_per_item` is per leaf cell for `derived` and per sample point and
+field for the samplers.
+
+## Build Example
+
+```bash
+qcc -O2 -Wall -disable-dimensions -I../src-local sampling-kernel.c \
+  -o sampling-kernel -lm
+./sampling-kernel 11 400 5
+```
+*/
+
+#include "utils.h"
+#include "output.h"
+#include "fractions.h"
+
+scalar f[];
+vector u[];
+
+scalar A11[], A12[], A22[]; // conformation tensor
+scalar AThTh[];
+
+scalar D2c[], vel[], trA[];
+
+#include "elastic-sampling.h"
+
+/**
+### neck()
+
+Interface radius of the benchmark thread: unit radius with a neck of
+radius `0.1` at `x = 2*pi`. */
+
+static double neck (double x)
+{
+  return 1. - 0.9*sq(sin(x/4.));
+}
+
+/**
+### fill_state()
+
+Refines the tree to `maxlevel` within a few cells of the interface and fills
+`f`, `u` and the conformation tensor. The same `seed` always yields the
+same state.
+*/
+static void fill_state (int maxlevel, unsigned int seed)
+{
+  init_grid (1 << 6);
+  refine (level < maxlevel && fabs(y - neck(x)) < 4.*Delta);
+  fraction (f, neck(x) - y);
+
+  srand (seed);
+  foreach (serial) {
+    A11[] = 1. + 2.*fabs(noise());
+    A22[] = 1. + 2.*fabs(noise());
+    A12[] = 0.9*noise()*sqrt(A11[]*A22[]);
+    AThTh[] = 1. + fabs(noise());
+    foreach_dimension()
+      u.x[] = noise();
+  }
+}
+
+int main (int argc, char const * argv[])
+{
+  int level = argc > 1 ? atoi (argv[1]) : 11;
+  int ny = argc > 2 ? atoi (argv[2]) : 400;
+  int repeats = argc > 3 ? atoi (argv[3]) : 5;
+  if (level < 6 || ny <= 0 || repeats <= 0) {
+    fprintf (ferr, "Usage: %s [level >= 6] [ny] [repeats]\n", argv[0]);
+    return 1;
+  }
+
+  L0 = 4*pi;
+  fill_state (level, 1);
+
+  long cells = 0;
+  foreach (reduction(+:cells))
+    cells++;
+
+  double xmin = 0., xmax = L0, ymin = 0., ymax = 1.;
+  int nx = ny*(xmax - xmin)/(ymax - ymin);
+  long samples = (long) nx*ny;
+  scalar * list = {D2c, vel, trA};
+  int len = list_len (list);
+  double * walk = malloc (len*samples*sizeof(double));
+  double * located = malloc (len*samples*sizeof(double));
+
+  bool want[ELASTIC_NFIELDS] = {true, true, true};
+  timer start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    elastic_derived_fields (D2c, vel, trA, want);
+  double t_derived = 1e9*timer_elapsed (start)/((double) repeats*cells);
+
+  start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    elastic_sample_window (list, xmin, ymin, xmax, ymax, nx, ny, walk);
+  double t_walk = 1e9*timer_elapsed (start)/((double) repeats*len*samples);
+
+  start = timer_start();
+  for (int n = 0; n < repeats; n++)
+    elastic_sample_window_located (list, xmin, ymin, xmax, ymax, nx, ny,
+                                   located);
+  double t_located = 1e9*timer_elapsed (start)/((double) repeats*len*samples);
+
+  double max_diff = 0.;
+  for (long k = 0; k < len*samples; k++)
+    if (walk[k] != nodata && located[k] != nodata)
+      max_diff = max (max_diff, fabs(walk[k] - located[k]));
+    else if (walk[k] != located[k])
+      max_diff = HUGE;
+
+  printf ("kernel level cells samples repeats ns_per_item max_diff\n");
+  printf ("derived %d %ld %ld %d %.3f %g\n",
+          level, cells, samples, repeats, t_derived, 0.);
+  printf ("sample_window %d %ld %ld %d %.3f %g\n",
+          level, cells, samples, repeats, t_walk, 0.);
+  printf ("sample_window_located %d %ld %ld %d %.3f %g\n",
+          level, cells, samples, repeats, t_located, max_diff);
+  printf ("# speedup leaf walk %.3f\n", t_located/t_walk);
+
+  free (walk);
+  free (located);
+  free_grid();
+  return 0;
+}
@@ -0,0 +1,181 @@
+#!/bin/bash
+# strong-scaling.sh
+#
+# Strong-scaling benchmark for one simulation case under MPI, optionally
+# next to the OpenMP build of the same case.
+# The case is compiled once with -D_MPI=1 (and once with -fopenmp for
+# --threads), then the same short run (fixed MAXlevel and tmax) is repeated
+# for each rank or thread count in a fresh directory. Wall-clock time,
+# speedup and parallel efficiency relative to the smallest count of each
+# backend are written as CSV, and with --plot as a speedup curve.
+#
+# Usage:
+#   bash benchmarks/strong-scaling.sh [--exec LiquidInThinning.c] [--ranks "1 2 4 8"]
+#                                     [--threads "1 2 4 8"] [--MAXlevel 14]
+#                                     [--tmax 0.01] [--out FILE] [--plot]
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_DIR="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+usage() {
+  cat <<'EOF'
+Usage: bash benchmarks/strong-scaling.sh [OPTIONS]
+
+Options:
+  --exec FILE    C source in simulationCases/ (default: LiquidInThinning.c)
+  --params FILE  Base parameter file (default: default.params)
+  --ranks LIST   Space-separated MPI rank counts (default: "1 2 4 8")
+  --threads LIST Space-separated OpenMP thread counts, run with the
+                 OpenMP build of the case (default: none)
+  --MAXlevel N   Refinement level of the benchmark run (default: 14)
+  --tmax T       Simulated time per run (default: 0.01)
+  --mpirun S     MPI launch prefix; "{N}" is replaced by the rank count
+                 (default: "mpirun -np {N}")
+  --out FILE     CSV output (default: benchmarks/strong-scaling.csv)
+  --plot         Also plot speedup against workers, with the ideal line,
+                 to FILE with a .png suffix (needs gnuplot)
+  -h, --help     Show this help message
+
+Output columns: backend,workers,seconds,speedup,efficiency
+(backend is mpi or openmp; workers is ranks or threads)
+EOF
+}
+
+EXEC_CODE="LiquidInThinning.c"
+PARAM_FILE="${REPO_DIR}/default.params"
+RANKS="1 2 4 8"
+THREADS=""
+PLOT=0
+MAX_LEVEL=14
+TMAX=0.01
+MPI_LAUNCHER="mpirun -np {N}"
+OUT_FILE="${SCRIPT_DIR}/strong-scaling.csv"
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -h|--help) usage; exit 0 ;;
+    --exec) EXEC_CODE="$2"; shift 2 ;;
+    --params) PARAM_FILE="$2"; shift 2 ;;
+    --ranks) RANKS="$2"; shift 2 ;;
+    --threads) THREADS="$2"; shift 2 ;;
+    --plot) PLOT=1; shift ;;
+    --MAXlevel) MAX_LEVEL="$2"; shift 2 ;;
+    --tmax) TMAX="$2"; shift 2 ;;
+    --mpirun) MPI_LAUNCHER="$2"; shift 2 ;;
+    --out) OUT_FILE="$2"; shift 2 ;;
+    *)
+      echo "ERROR: Unknown argument: $1" >&2
+      usage
+      exit 1
+      ;;
+  esac
+done
+
+if [[ -f "${REPO_DIR}/.project_config" ]]; then
+  # shellcheck disable=SC1091
+  source "${REPO_DIR}/.project_config"
+fi
+
+MPI_CC="${MPI_CC:-mpicc}"
+TOOLS=(qcc "$MPI_CC")
+if [[ $PLOT -eq 1 ]]; then
+  TOOLS+=(gnuplot)
+fi
+for tool in "${TOOLS[@]}"; do
+  if ! command -v "$tool" >/dev/null 2>&1; then
+    echo "ERROR: ${tool} not found in PATH." >&2
+    exit 1
+  fi
+done
+
+SRC_FILE="${REPO_DIR}/simulationCases/${EXEC_CODE}"
+if [[ ! -f "$SRC_FILE" || ! -f "$PARAM_FILE" ]]; then
+  echo "ERROR: missing source or parameter file." >&2
+  exit 1
+fi
+
+WORK_DIR="${SCRIPT_DIR}/strong-scaling-runs"
+EXECUTABLE="${WORK_DIR}/${EXEC_CODE%.c}"
+mkdir -p "$WORK_DIR"
+cp "$SRC_FILE" "$WORK_DIR/"
+
+echo "Compiling ${EXEC_CODE} with MPI ..."
+(
+  cd "$WORK_DIR"
+  CC99="${MPI_CC} -std=c99" qcc -I"${REPO_DIR}/src-local" -O2 -Wall \
+    -disable-dimensions -D_MPI=1 "${EXEC_CODE}" -o "${EXECUTABLE}-mpi" -lm
+  if [[ -n "$THREADS" ]]; then
+    echo "Compiling ${EXEC_CODE} with OpenMP ..."
+    qcc -I"${REPO_DIR}/src-local" -O2 -Wall -disable-dimensions -fopenmp \
+      "${EXEC_CODE}" -o "${EXECUTABLE}-openmp" -lm
+  fi
+)
+
+echo "backend,workers,seconds,speedup,efficiency" > "$OUT_FILE"
+
+# run_series BACKEND LIST: one fresh run per worker count, timed end to end.
+run_series() {
+  local backend="$1" counts="$2" base_n="" base_s=""
+  local n run_dir start end seconds
+  for n in $counts; do
+    run_dir="${WORK_DIR}/${backend}${n}"
+    rm -rf "$run_dir"
+    mkdir -p "$run_dir"
+    # Fresh directory: no restart file, identical initial condition.
+    grep -v -E '^[[:space:]]*(MAXlevel|tmax|logEchoEvery)[[:space:]]*=' "$PARAM_FILE" \
+      > "${run_dir}/case.params"
+    printf 'MAXlevel=%s\ntmax=%s\nlogEchoEvery=0\n' "$MAX_LEVEL" "$TMAX" \
+      >> "${run_dir}/case.params"
+
+    local -a launcher=() omp=(OMP_NUM_THREADS=1)
+    if [[ "$backend" == "mpi" ]]; then
+      read -r -a launcher <<< "${MPI_LAUNCHER//\{N\}/$n}"
+    else
+      omp=(OMP_NUM_THREADS="$n")
+    fi
+    echo "Running ${backend} with ${n}: ${omp[*]} ${launcher[*]-} ${EXECUTABLE##*/}-${backend} case.params"
+    start=$(date +%s.%N)
+    (cd "$run_dir" && env "${omp[@]}" ${launcher[@]+"${launcher[@]}"} "${EXECUTABLE}-${backend}" \
+      case.params > run.out 2>&1)
+    end=$(date +%s.%N)
+
+    seconds=$(awk -v a="$start" -v b="$end" 'BEGIN { printf "%.3f", b - a }')
+    if [[ -z "$base_s" ]]; then
+      base_n="$n"
+      base_s="$seconds"
+    fi
+    awk -v b="$backend" -v n="$n" -v s="$seconds" -v n0="$base_n" -v s0="$base_s" 'BEGIN {
+      speedup = s0/s
+      printf "%s,%d,%.3f,%.3f,%.3f\n", b, n, s, speedup, speedup*n0/n
+    }' | tee -a "$OUT_FILE"
+  done
+}
+
+run_series mpi "$RANKS"
+if [[ -n "$THREADS" ]]; then
+  run_series openmp "$THREADS"
+fi
+
+echo "Strong-scaling results: ${OUT_FILE}"
+
+if [[ $PLOT -eq 1 ]]; then
+  PLOT_FILE="${OUT_FILE%.csv}.png"
+  series="'< grep ^mpi, ${OUT_FILE}' using 2:4 with linespoints title 'MPI'"
+  if [[ -n "$THREADS" ]]; then
+    series+=", '< grep ^openmp, ${OUT_FILE}' using 2:4 with linespoints title 'OpenMP'"
+  fi
+  gnuplot <<EOF
+set terminal pngcairo size 800,600
+set output '${PLOT_FILE}'
+set datafile separator ','
+set logscale xy 2
+set xlabel 'workers (ranks or threads)'
+set ylabel 'speedup'
+set title 'Strong scaling: ${EXEC_CODE%.c}, MAXlevel ${MAX_LEVEL}, tmax ${TMAX}'
+set key top left
+plot ${series}, x title 'ideal' with lines dashtype 2
+EOF
+  echo "Strong-scaling curve: ${PLOT_FILE}"
+fi
@@ -7,18 +7,32 @@ axisymmetric two-phase runs.
 
 ## Pipeline
 
-1. Restore each snapshot.
+1. Restore each snapshot once with `getFrame-elastic.c`, or, with
+   `--insitu`, read the `insitu/frame-*.bin` files written during the run.
 2. Sample `vel` plus one left-overlay scalar (`trA` by default, `D2` via flag)
-   on a uniform grid using `getData-elastic.c`.
-3. Extract `f` interface facets via `output_facets(f, ...)`.
+   on a uniform grid, transferred as binary `float32` columns
+   (see `src-local/field-grid-io.h`).
+3. Extract `f` interface facets from the same restore, appended to the
+   same binary stream together with the snapshot time.
 4. Mirror about the axis of symmetry `y = 0` and render the full
    axisymmetric cross-section with the interface overlaid.
-5. Write PNG frames and optionally assemble an MP4 with `ffmpeg`.
+5. Stream frames to `ffmpeg` in order as workers finish them, as raw RGB
+   canvases by default (`--frame-format raw`) or as PNG images
+   (`--frame-format png`); PNG frames are written to disk for archival
+   with `--keep-frames` or `--skip-video`.
+
+## Snapshot Selection
+
+Snapshots are taken from `intermediate/snapshots.index` when the case wrote
+one (exact times, iteration, size, neck radius, deepest level). Otherwise
+they are found by glob and filename time. `--start-time`, `--end-time`,
+`--hm-min`, `--hm-max`, `--preview-dt` and `--max-frames` then filter the
+list.
 
 ## Dependencies
 
-- `qcc`: builds helper binaries from `getFacet.c` and
-  `getData-elastic.c`.
+- `qcc`: builds helper binaries from `getFacet.c` (plot window detection)
+  and `getFrame-elastic.c` (per-frame extraction).
 - `numpy`: parsing, masking, and percentile-based color scaling.
 - `matplotlib`: frame rendering.
 - `ffmpeg`: optional MP4 assembly (skipped with `--skip-video`).
@@ -38,25 +52,57 @@ axisymmetric two-phase runs.
   side is created only by mirroring in post-processing.
 - Default duration: `10 s` with `fps = N_frames / duration` when `--fps` is unset.
 
+## Cache
+
+With `--cache-dir DIR` (inside the case directory unless absolute), the
+extracted field grids and facets of every snapshot and the rendered frames
+are kept in a content-addressed store (see `FrameCache`) and the compiled
+helpers next to them. A rerun, e.g. while the simulation is still writing
+snapshots, only extracts and renders the new snapshots; after a change of
+colormap or color limits it re-renders from the cached grids without
+calling the C helpers. Cached frames are listed as `cached` in the progress
+output.
+
+## Several Cases
+
+`--case-dir` may be repeated. All cases then share one pool of `--cpus`
+workers: the helpers are compiled once, the window detection of every case
+runs as a pool task, frames are submitted case after case through one
+sliding window, and the `ffmpeg` encode of a finished case completes while
+the next cases render. A failing case is reported and the others continue;
+outputs and frame directories are resolved inside each case directory.
+
 #### Example
 
 ```bash
 python3 postProcess/Video-generic.py --case-dir simulationCases/1000
+python3 postProcess/Video-generic.py --cpus 32 \
+  --case-dir simulationCases/c1000-in --case-dir simulationCases/c1000-out
 ```
 """
 
 from __future__ import annotations
 
 import argparse
+import copy
+import hashlib
 import math
 import os
 import shutil
+import struct
 import subprocess
 import sys
 import tempfile
-from concurrent.futures import ProcessPoolExecutor
+from concurrent.futures import (
+    FIRST_COMPLETED,
+    Future,
+    ProcessPoolExecutor,
+    ThreadPoolExecutor,
+    wait,
+)
+from io import BytesIO
 from pathlib import Path
-from typing import TYPE_CHECKING, Any
+from typing import IO, TYPE_CHECKING, Any, NamedTuple
 
 if TYPE_CHECKING:
     import numpy as _np_types
@@ -71,9 +117,17 @@ np: Any = None
 plt: Any = None
 LineCollection: Any = None
 WORKER_ENV_PID: int | None = None
+WORKER_FRAME_SERVER: FrameServer | None = None
 
 
-FIELD_INDEX = {"D2": 2, "vel": 3, "trA": 4}
+SNAPSHOT_COMPRESSED_SUFFIXES = (".gz", ".zst")
+SNAPSHOT_INDEX = "intermediate/snapshots.index"
+FIELD_NAME = {"D2": "D2c", "vel": "vel", "trA": "trA"}
+FIELD_GRID_MAGIC = b"EPOGRID1"
+FIELD_GRID_HEADER = struct.Struct("<8s4i4d")
+FIELD_GRID_NAME_LEN = 16
+FIELD_FACETS_MAGIC = b"EPOFACE1"
+FIELD_FACETS_HEADER = struct.Struct("<8sdq")
 FIELD_LABEL = {
     "D2": r"$\log_{10}\!\left(\|\mathcal{D}\|\right)$",
     "vel": r"$\lvert \mathbf{u} \rvert$",
@@ -95,16 +149,31 @@ def parse_args() -> argparse.Namespace:
     parser.add_argument(
         "--case-dir",
         type=Path,
+        action="append",
         default=None,
         help=(
-            "Case directory containing `intermediate/snapshot-*`. "
+            "Case directory containing `intermediate/snapshot-*`. Repeat to render "
+            "several cases through one worker pool. "
             "Default: auto-detect from current directory and simulationCases/."
         ),
     )
     parser.add_argument(
         "--snap-glob",
-        default="intermediate/snapshot-*",
-        help="Snapshot glob pattern relative to `case-dir`.",
+        default=None,
+        help=(
+            "Snapshot glob pattern relative to `case-dir` "
+            "(default: `intermediate/snapshot-*`, or `insitu/frame-*.bin` with --insitu)."
+        ),
+    )
+    parser.add_argument(
+        "--insitu",
+        action="store_true",
+        help=(
+            "Render the in-situ frame files written by the simulation "
+            "(`tframe > 0`) instead of restoring snapshots. The sampling window "
+            "and resolution are those of the frames; --xmin/--xmax/--ymin/--ymax/--ny "
+            "are ignored."
+        ),
     )
     parser.add_argument(
         "--ny",
@@ -118,7 +187,10 @@ def parse_args() -> argparse.Namespace:
         dest="cpus",
         type=int,
         default=4,
-        help="Number of worker processes for snapshot rendering (default: 4).",
+        help=(
+            "Number of worker processes for snapshot rendering, shared by all "
+            "cases (default: 4)."
+        ),
     )
     parser.add_argument(
         "--fps",
@@ -141,7 +213,27 @@ def parse_args() -> argparse.Namespace:
     parser.add_argument(
         "--frames-dir",
         type=Path,
-        help="Directory for PNG frames (default: case-dir/Video).",
+        help=(
+            "Directory for PNG frames when they are kept on disk "
+            "(default: case-dir/Video)."
+        ),
+    )
+    parser.add_argument(
+        "--keep-frames",
+        action="store_true",
+        help=(
+            "Also write PNG frames to frames-dir while streaming them to ffmpeg "
+            "(implies --frame-format png)."
+        ),
+    )
+    parser.add_argument(
+        "--frame-format",
+        choices=("raw", "png"),
+        default="raw",
+        help=(
+            "How frames reach ffmpeg: `raw` RGB canvases (default, no image "
+            "compression) or `png` images (tightly cropped, as archived)."
+        ),
     )
     parser.add_argument(
         "--clean-frames",
@@ -159,7 +251,7 @@ def parse_args() -> argparse.Namespace:
     parser.add_argument(
         "--skip-video",
         action="store_true",
-        help="Only write PNG frames and skip ffmpeg MP4 assembly.",
+        help="Only write PNG frames to frames-dir and skip ffmpeg MP4 assembly.",
     )
     parser.add_argument(
         "--ffmpeg",
@@ -171,6 +263,48 @@ def parse_args() -> argparse.Namespace:
         "--start-time", type=float, help="Skip snapshots with t < this."
     )
     parser.add_argument("--end-time", type=float, help="Skip snapshots with t > this.")
+    parser.add_argument(
+        "--preview-dt",
+        type=float,
+        help=(
+            "Time-uniform subsampling: render the first snapshot at or after "
+            "each multiple of this interval (fast previews)."
+        ),
+    )
+    parser.add_argument(
+        "--hm-min",
+        type=float,
+        help=(
+            "Skip snapshots whose minimum neck radius is below this "
+            "(needs the snapshot index)."
+        ),
+    )
+    parser.add_argument(
+        "--hm-max",
+        type=float,
+        help=(
+            "Skip snapshots whose minimum neck radius is above this "
+            "(needs the snapshot index)."
+        ),
+    )
+    parser.add_argument(
+        "--cache-dir",
+        type=Path,
+        default=None,
+        help=(
+            "Keep extracted field grids and rendered frames in this directory "
+            "(relative paths resolved inside case-dir) and reuse them on later "
+            "runs. Default: no cache."
+        ),
+    )
+    parser.add_argument(
+        "--no-index",
+        action="store_true",
+        help=(
+            f"Ignore `{SNAPSHOT_INDEX}` and discover snapshots by glob and "
+            "filename time parsing."
+        ),
+    )
     parser.add_argument(
         "--vel-vmin",
         type=float,
@@ -335,6 +469,96 @@ def configure_worker_environment(cache_root: Path | None) -> None:
     WORKER_ENV_PID = pid
 
 
+class FrameServer:
+    """
+    Long-running `getFrame-elastic --serve` process owned by one worker.
+
+    Requests are sent as one whitespace-separated line; each reply is an
+    `int64` byte count followed by the frame products, or `0` on failure.
+    """
+
+    def __init__(self, frame_bin: Path, case_dir: Path) -> None:
+        self.owner_pid = os.getpid()
+        self.case_dir = case_dir
+        self.process = subprocess.Popen(
+            [str(frame_bin), "--serve"],
+            cwd=case_dir,
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+        )
+
+    def request(self, arguments: list[str]) -> bytes:
+        """
+        Send one request and return the frame products.
+
+        #### Raises
+
+        - `RuntimeError`: The server rejects the request or exits.
+        """
+        if any(not arg or any(ch.isspace() for ch in arg) for arg in arguments):
+            raise ValueError(f"Frame server arguments must not contain spaces: {arguments}")
+        assert self.process.stdin is not None and self.process.stdout is not None
+        try:
+            self.process.stdin.write((" ".join(arguments) + "\n").encode())
+            self.process.stdin.flush()
+        except BrokenPipeError as exc:
+            raise RuntimeError("Frame server exited unexpectedly.") from exc
+
+        head = self.process.stdout.read(8)
+        if len(head) < 8:
+            raise RuntimeError("Frame server exited unexpectedly.")
+        (nbytes,) = struct.unpack("<q", head)
+        if nbytes <= 0:
+            raise RuntimeError(f"Frame server could not extract: {arguments[0]}")
+        raw = self.process.stdout.read(nbytes)
+        if len(raw) < nbytes:
+            raise RuntimeError("Truncated frame server reply.")
+        return raw
+
+    def close(self) -> None:
+        """
+        Close the request stream and wait for the server to exit.
+        """
+        if self.process.stdin is not None:
+            self.process.stdin.close()
+        self.process.wait()
+
+
+def worker_frame_server(frame_bin: Path, case_dir: Path) -> FrameServer:
+    """
+    Return this process's frame server for `case_dir`, starting it on first
+    use and restarting it when the worker moves on to another case.
+
+    Servers inherited through `fork` belong to the parent and are never reused.
+    """
+    global WORKER_FRAME_SERVER
+
+    server = WORKER_FRAME_SERVER
+    if (
+        server is None
+        or server.owner_pid != os.getpid()
+        or server.case_dir != case_dir
+        or server.process.poll() is not None
+    ):
+        if server is not None and server.owner_pid == os.getpid():
+            server.close()
+        server = FrameServer(frame_bin, case_dir)
+        WORKER_FRAME_SERVER = server
+    return server
+
+
+def close_worker_frame_server() -> None:
+    """
+    Shut down this process's frame server, if any.
+    """
+    global WORKER_FRAME_SERVER
+
+    server = WORKER_FRAME_SERVER
+    if server is not None and server.owner_pid == os.getpid():
+        server.close()
+    WORKER_FRAME_SERVER = None
+
+
 def run_capture(cmd: list[str], cwd: Path | None = None) -> str:
     """
     Run a subprocess and return combined `stdout` + `stderr` text.
@@ -363,6 +587,89 @@ def run_capture(cmd: list[str], cwd: Path | None = None) -> str:
     return (result.stdout or "") + (result.stderr or "")
 
 
+def run_capture_bytes(cmd: list[str], cwd: Path | None = None) -> bytes:
+    """
+    Run a subprocess and return its raw `stdout` bytes.
+
+    #### Raises
+
+    - `subprocess.CalledProcessError`: The command exits with a non-zero code.
+    """
+    result = subprocess.run(
+        cmd,
+        cwd=cwd,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        check=True,
+    )
+    return result.stdout
+
+
+def parse_field_grid(
+    raw: bytes,
+) -> tuple[NDArray, NDArray, dict[str, NDArray], int]:
+    """
+    Decode the binary container written by `field-grid-io.h`.
+
+    #### Returns
+
+    - `tuple[NDArray, NDArray, dict[str, NDArray], int]`: `(x, y, fields, end)`
+      with cell-center coordinates, one `(ny, nx)` array per field name and
+      the byte offset just past the last column.
+    """
+    if len(raw) < FIELD_GRID_HEADER.size:
+        raise RuntimeError("Truncated field grid header.")
+    magic, nx, ny, nfields, value_bytes, xmin, ymin, xmax, ymax = (
+        FIELD_GRID_HEADER.unpack_from(raw, 0)
+    )
+    if magic != FIELD_GRID_MAGIC or value_bytes not in (4, 8):
+        raise RuntimeError("Unrecognized field grid format.")
+
+    offset = FIELD_GRID_HEADER.size
+    names = []
+    for _ in range(nfields):
+        name = raw[offset : offset + FIELD_GRID_NAME_LEN].split(b"\0", 1)[0]
+        names.append(name.decode("ascii"))
+        offset += FIELD_GRID_NAME_LEN
+
+    dtype = np.float32 if value_bytes == 4 else np.float64
+    count = nx * ny
+    if len(raw) < offset + nfields * count * value_bytes:
+        raise RuntimeError("Truncated field grid data.")
+    fields = {}
+    for name in names:
+        column = np.frombuffer(raw, dtype=dtype, count=count, offset=offset)
+        fields[name] = column.reshape(ny, nx).astype(float)
+        offset += count * value_bytes
+
+    x = xmin + (np.arange(nx) + 0.5) * (xmax - xmin) / nx
+    y = ymin + (np.arange(ny) + 0.5) * (ymax - ymin) / ny
+    return x, y, fields, offset
+
+
+def parse_facet_section(raw: bytes, offset: int) -> tuple[float, NDArray]:
+    """
+    Decode the `EPOFACE1` facet section written by `field_grid_write_facets()`.
+
+    #### Returns
+
+    - `tuple[float, NDArray]`: `(t, segments)` with the snapshot time and an
+      `N x 2 x 2` segment array.
+    """
+    if len(raw) < offset + FIELD_FACETS_HEADER.size:
+        raise RuntimeError("Truncated facet section header.")
+    magic, t, count = FIELD_FACETS_HEADER.unpack_from(raw, offset)
+    if magic != FIELD_FACETS_MAGIC or count < 0:
+        raise RuntimeError("Unrecognized facet section format.")
+    offset += FIELD_FACETS_HEADER.size
+    if len(raw) < offset + 32 * count:
+        raise RuntimeError("Truncated facet section data.")
+    if count == 0:
+        return t, np.empty((0, 2, 2), dtype=float)
+    segments = np.frombuffer(raw, dtype=np.float64, count=4 * count, offset=offset)
+    return t, segments.reshape(count, 2, 2).copy()
+
+
 def snapshot_argument(snapshot: Path, case_dir: Path) -> str:
     """
     Return a case-relative snapshot path when possible.
@@ -375,18 +682,132 @@ def snapshot_argument(snapshot: Path, case_dir: Path) -> str:
 
 def snapshot_time(path: Path) -> float:
     """
-    Extract time from a filename of form `snapshot-<time>`.
+    Extract time from a filename of form `snapshot-<time>` (optionally
+    followed by a `.gz` or `.zst` compression suffix) or `frame-<time>.bin`.
     """
     name = path.name
-    if "snapshot-" not in name:
+    for suffix in (*SNAPSHOT_COMPRESSED_SUFFIXES, ".bin"):
+        if name.endswith(suffix):
+            name = name[: -len(suffix)]
+            break
+    for prefix in ("snapshot-", "frame-"):
+        if prefix in name:
+            break
+    else:
         return math.inf
-    raw = name.split("snapshot-", 1)[1]
+    raw = name.split(prefix, 1)[1]
     try:
         return float(raw)
     except ValueError:
         return math.inf
 
 
+class SnapshotEntry(NamedTuple):
+    """
+    One snapshot with its time and, when read from the snapshot index, the
+    metadata recorded by the simulation (`None` otherwise).
+    """
+
+    path: Path
+    t: float
+    i: int | None = None
+    bytes: int | None = None
+    hm: float | None = None
+    maxlevel: int | None = None
+
+
+def read_snapshot_index(case_dir: Path) -> list[SnapshotEntry] | None:
+    """
+    Read `intermediate/snapshots.index` written by the simulation cases.
+
+    The index is append-only: snapshots rewritten after a restart appear
+    again, and the last row of each file wins. Listed files are not
+    statted.
+
+    #### Returns
+
+    - `list[SnapshotEntry] | None`: entries sorted by time, or `None` when
+      the index does not exist.
+    """
+    index_path = case_dir / SNAPSHOT_INDEX
+    try:
+        text = index_path.read_text(encoding="utf-8")
+    except OSError:
+        return None
+
+    latest: dict[str, SnapshotEntry] = {}
+    for raw in text.splitlines():
+        fields = raw.split()
+        if len(fields) != 6 or fields[0].startswith("#"):
+            continue
+        try:
+            entry = SnapshotEntry(
+                path=case_dir / fields[0],
+                t=float(fields[1]),
+                i=int(fields[2]),
+                bytes=int(fields[3]),
+                hm=float(fields[4]),
+                maxlevel=int(fields[5]),
+            )
+        except ValueError:
+            continue
+        latest[fields[0]] = entry
+    return sorted(latest.values(), key=lambda e: e.t)
+
+
+def subsample_uniform_time(
+    entries: list[SnapshotEntry], dt: float
+) -> list[SnapshotEntry]:
+    """
+    Keep the first entry at or after each multiple of `dt` past the first
+    entry, so that previews are uniform in simulation time even where the
+    snapshot cadence changes.
+    """
+    if not entries:
+        return entries
+    picked: list[SnapshotEntry] = []
+    next_t = entries[0].t
+    for entry in entries:
+        if entry.t >= next_t - 1e-12:
+            picked.append(entry)
+            next_t = entry.t + dt
+    return picked
+
+
+def select_snapshots(
+    case_dir: Path, args: argparse.Namespace, use_index: bool
+) -> list[Path]:
+    """
+    Select the snapshots to render from the index (when `use_index` and it
+    exists) or by glob, then apply the time, neck-radius, subsampling and
+    frame-count filters of `args`.
+    """
+    entries = read_snapshot_index(case_dir) if use_index else None
+    if entries is not None:
+        print(f"Using snapshot index: {case_dir / SNAPSHOT_INDEX}", file=sys.stderr)
+    else:
+        if args.hm_min is not None or args.hm_max is not None:
+            raise ValueError("--hm-min/--hm-max need the snapshot index.")
+        entries = [
+            SnapshotEntry(path=p, t=snapshot_time(p))
+            for p in list_snapshots(case_dir, args.snap_glob)
+        ]
+
+    if args.start_time is not None:
+        entries = [e for e in entries if e.t >= args.start_time]
+    if args.end_time is not None:
+        entries = [e for e in entries if e.t <= args.end_time]
+    if args.hm_min is not None:
+        entries = [e for e in entries if e.hm is not None and e.hm >= args.hm_min]
+    if args.hm_max is not None:
+        entries = [e for e in entries if e.hm is not None and e.hm <= args.hm_max]
+    if args.preview_dt is not None:
+        entries = subsample_uniform_time(entries, args.preview_dt)
+    if args.max_frames is not None:
+        entries = entries[: args.max_frames]
+    return [e.path for e in entries]
+
+
 def list_snapshots(case_dir: Path, pattern: str) -> list[Path]:
     """
     Collect and sort snapshot files by simulation time.
@@ -474,6 +895,7 @@ def compile_get_helper(source: Path, output: Path) -> None:
         "-O2",
         "-Wall",
         "-disable-dimensions",
+        f"-I{source.parent.parent / 'src-local'}",
         source.name,
         "-o",
         str(output),
@@ -486,29 +908,32 @@ def precompile_get_helpers(script_dir: Path, build_dir: Path) -> tuple[Path, Pat
     """
     Pre-processing step: compile get* helper binaries before rendering.
 
+    `getFacet` is only used on the first snapshot to resolve the plot window;
+    every frame is then extracted by `getFrame-elastic` with one restore.
+
     #### Returns
 
-    - `tuple[Path, Path]`: `(facet_bin, data_bin)`.
+    - `tuple[Path, Path]`: `(facet_bin, frame_bin)`.
     """
     if shutil.which("qcc") is None:
         raise RuntimeError("qcc not found in PATH.")
 
     facet_src = script_dir / "getFacet.c"
-    data_src = script_dir / "getData-elastic.c"
+    frame_src = script_dir / "getFrame-elastic.c"
 
-    if not facet_src.exists() or not data_src.exists():
+    if not facet_src.exists() or not frame_src.exists():
         raise FileNotFoundError(
             "Required files not found in postProcess/: "
-            "getFacet.c and/or getData-elastic.c"
+            "getFacet.c and/or getFrame-elastic.c"
         )
 
     facet_bin = build_dir / "getFacet"
-    data_bin = build_dir / "getData-elastic"
+    frame_bin = build_dir / "getFrame-elastic"
 
     compile_get_helper(facet_src, facet_bin)
-    compile_get_helper(data_src, data_bin)
+    compile_get_helper(frame_src, frame_bin)
 
-    return facet_bin, data_bin
+    return facet_bin, frame_bin
 
 
 def parse_facet_segments(raw: str) -> NDArray:
@@ -536,11 +961,22 @@ def parse_facet_segments(raw: str) -> NDArray:
     return arr.reshape(-1, 2, 2)
 
 
-def get_facets(snapshot: Path, facet_bin: Path, case_dir: Path) -> NDArray:
+def get_facets(
+    snapshot: Path, facet_bin: Path, case_dir: Path, cache: FrameCache | None = None
+) -> NDArray:
     """
-    Extract interface segments for `f`.
+    Extract interface segments for `f`, through `cache` when given.
     """
+    key: str | None = None
+    if cache is not None:
+        key = cache.grid_key(case_dir, snapshot, [snapshot.name, "getFacet"])
+        raw_bytes = cache.load(case_dir, "grids", key)
+        if raw_bytes is not None:
+            return parse_facet_segments(raw_bytes.decode())
     raw = run_capture([str(facet_bin), snapshot_argument(snapshot, case_dir)], cwd=case_dir)
+    if key is not None:
+        assert cache is not None
+        cache.store(case_dir, "grids", key, raw.encode())
     return parse_facet_segments(raw)
 
 
@@ -590,75 +1026,218 @@ def resolve_plot_window_from_facets(
     return x_min_plot, x_max_plot, y_min_plot, y_max_plot
 
 
-def get_field_grid(
+def resolve_window_from_first_snapshot(
+    args: argparse.Namespace, snapshot: Path, facet_bin: Path, case_dir: Path
+) -> None:
+    """
+    Resolve `args.xmin/xmax/ymin/ymax` from the facets of the first snapshot.
+    """
+    first_facets = get_facets(snapshot, facet_bin, case_dir, args.frame_cache)
+    (
+        args.xmin,
+        args.xmax,
+        args.ymin,
+        args.ymax,
+    ) = resolve_plot_window_from_facets(
+        interface_segments=first_facets,
+        xmin=args.xmin,
+        xmax=args.xmax,
+        ymin=args.ymin,
+        ymax=args.ymax,
+    )
+    print(
+        (
+            f"Using plot window: z in [{args.xmin:.6g}, {args.xmax:.6g}], "
+            f"r in [{args.ymin:.6g}, {args.ymax:.6g}]"
+        ),
+        file=sys.stderr,
+    )
+
+
+class FrameCache:
+    """
+    Content-addressed store of extracted frame products and rendered frames.
+
+    Entries live under `<root>/grids/` and `<root>/frames/`, named by a
+    SHA-256 key and written atomically, so concurrent workers and
+    interrupted runs never leave a partial entry.
+
+    - Grid key: the snapshot identity (case-relative path, or absolute path
+      for a cache shared by several cases, size, `mtime`),
+      the helper request (fields, window, `ny`, format) and a digest of the
+      extraction sources.
+    - Frame key: the grid key, the render arguments (window, colormaps,
+      color limits, left field, frame format) and a digest of this script.
+
+    A rewritten snapshot (new size or `mtime`) or a changed helper or
+    renderer thus misses the cache. Nothing is evicted; delete the
+    directory to reclaim space.
+    """
+
+    def __init__(self, root: Path, extract_salt: str, render_salt: str) -> None:
+        self.root = root
+        self.extract_salt = extract_salt
+        self.render_salt = render_salt
+
+    def directory(self, case_dir: Path) -> Path:
+        """
+        Cache directory of `case_dir`.
+        """
+        return self.root if self.root.is_absolute() else case_dir / self.root
+
+    def grid_key(self, case_dir: Path, snapshot: Path, request: list[str]) -> str:
+        """
+        Key of the extracted products of `snapshot` for `request`.
+        """
+        st = snapshot.stat()
+        name = (
+            str(snapshot.resolve())
+            if self.root.is_absolute()
+            else snapshot_argument(snapshot, case_dir)
+        )
+        identity = [
+            self.extract_salt,
+            name,
+            str(st.st_size),
+            str(st.st_mtime_ns),
+            *request[1:],
+        ]
+        return hashlib.sha256("\0".join(identity).encode()).hexdigest()
+
+    def frame_key(self, grid_key: str, render: tuple[Any, ...]) -> str:
+        """
+        Key of the frame rendered from `grid_key` with the `render` arguments.
+        """
+        identity = [self.render_salt, grid_key, *(repr(value) for value in render)]
+        return hashlib.sha256("\0".join(identity).encode()).hexdigest()
+
+    def _path(self, case_dir: Path, kind: str, key: str) -> Path:
+        return self.directory(case_dir) / kind / key[:2] / key
+
+    def load(self, case_dir: Path, kind: str, key: str) -> bytes | None:
+        """
+        Return the `kind` (`grids` or `frames`) entry `key`, or `None`.
+        """
+        try:
+            return self._path(case_dir, kind, key).read_bytes()
+        except OSError:
+            return None
+
+    def store(self, case_dir: Path, kind: str, key: str, data: bytes) -> None:
+        """
+        Store `data` as the `kind` entry `key`; failures only skip caching.
+        """
+        path = self._path(case_dir, kind, key)
+        tmp = path.with_name(f"{key}.tmp{os.getpid()}")
+        try:
+            path.parent.mkdir(parents=True, exist_ok=True)
+            tmp.write_bytes(data)
+            os.replace(tmp, path)
+        except OSError as exc:
+            print(f"Warning: cannot write cache entry {path}: {exc}", file=sys.stderr)
+            tmp.unlink(missing_ok=True)
+
+
+def source_digest(paths: list[Path]) -> str:
+    """
+    SHA-256 of the concatenated contents of `paths` (missing files count as empty).
+    """
+    digest = hashlib.sha256()
+    for path in paths:
+        try:
+            digest.update(path.read_bytes())
+        except OSError:
+            pass
+        digest.update(b"\0")
+    return digest.hexdigest()
+
+
+def frame_request(
     snapshot: Path,
-    data_bin: Path,
     case_dir: Path,
-    field_key: str,
+    field_keys: list[str],
     xmin: float,
     ymin: float,
     xmax: float,
     ymax: float,
     ny: int,
-) -> tuple[NDArray, NDArray, MaskedArray]:
-    """
-    Sample one derived field on a uniform grid inside `[xmin, xmax] x [ymin, ymax]`.
-    """
-    raw = run_capture(
-        [
-            str(data_bin),
-            snapshot_argument(snapshot, case_dir),
-            f"{xmin:.16g}",
-            f"{ymin:.16g}",
-            f"{xmax:.16g}",
-            f"{ymax:.16g}",
-            str(ny),
-            "0",
-            "0",
-            "0",
-        ],
-        cwd=case_dir,
-    )
+) -> list[str]:
+    """
+    Arguments of one `getFrame-elastic` extraction.
+    """
+    names = list(dict.fromkeys(FIELD_NAME[key] for key in field_keys))
+    return [
+        snapshot_argument(snapshot, case_dir),
+        f"{xmin:.16g}",
+        f"{ymin:.16g}",
+        f"{xmax:.16g}",
+        f"{ymax:.16g}",
+        str(ny),
+        f"--fields={','.join(names)}",
+        "--format=float32",
+    ]
 
-    rows = []
-    for line in raw.splitlines():
-        line = line.strip()
-        if not line:
-            continue
-        vals = line.split()
-        if len(vals) < 5:
-            continue
-        try:
-            rows.append(
-                [
-                    float(vals[0]),
-                    float(vals[1]),
-                    float(vals[2]),
-                    float(vals[3]),
-                    float(vals[4]),
-                ]
-            )
-        except ValueError:
-            continue
 
-    if not rows:
-        raise RuntimeError(f"No field data parsed for snapshot: {snapshot}")
+def get_frame_products(
+    snapshot: Path,
+    frame_bin: Path | None,
+    case_dir: Path,
+    field_keys: list[str],
+    xmin: float,
+    ymin: float,
+    xmax: float,
+    ymax: float,
+    ny: int,
+    server: FrameServer | None = None,
+    cache: FrameCache | None = None,
+) -> tuple[float, NDArray, NDArray, dict[str, MaskedArray], NDArray]:
+    """
+    Extract the sampled fields and interface facets of one snapshot.
 
-    arr = np.asarray(rows, dtype=float)
-    x = arr[:, 0]
-    y = arr[:, 1]
-    field = arr[:, FIELD_INDEX[field_key]]
+    The helper restores the snapshot once, computes only the requested
+    fields and writes them as binary `float32` columns followed by the
+    facet section. With `server`, the request goes to a running
+    `--serve` helper instead of a new process. In-situ `.bin` frame files
+    already hold these products and are read directly (the window is then
+    the one they were sampled on). With `cache`, the products of a snapshot
+    already extracted with the same request are read from it instead.
 
-    x_unique = np.unique(x)
-    y_unique = np.unique(y)
-    ix = np.searchsorted(x_unique, x)
-    iy = np.searchsorted(y_unique, y)
+    #### Returns
 
-    grid = np.full((len(y_unique), len(x_unique)), np.nan, dtype=float)
-    grid[iy, ix] = field
+    - `tuple[float, NDArray, NDArray, dict[str, MaskedArray], NDArray]`:
+      `(t, x, y, fields, segments)` with the restored simulation time, the
+      grid coordinates, one masked `(ny, nx)` array per field key and the
+      `N x 2 x 2` interface segments.
+    """
+    names = list(dict.fromkeys(FIELD_NAME[key] for key in field_keys))
+    request = frame_request(snapshot, case_dir, field_keys, xmin, ymin, xmax, ymax, ny)
+    raw: bytes | None = None
+    key: str | None = None
+    if snapshot.suffix == ".bin":
+        raw = snapshot.read_bytes()
+    elif cache is not None:
+        key = cache.grid_key(case_dir, snapshot, request)
+        raw = cache.load(case_dir, "grids", key)
+    if raw is None:
+        if server is not None:
+            raw = server.request(request)
+        else:
+            assert frame_bin is not None
+            raw = run_capture_bytes([str(frame_bin), *request, "--out=-"], cwd=case_dir)
+        if key is not None:
+            assert cache is not None
+            cache.store(case_dir, "grids", key, raw)
+    x, y, grids, offset = parse_field_grid(raw)
+    if len(x) == 0 or len(y) == 0 or any(name not in grids for name in names):
+        raise RuntimeError(f"No field data parsed for snapshot: {snapshot}")
+    t, segments = parse_facet_section(raw, offset)
 
-    invalid = (~np.isfinite(grid)) | (np.abs(grid) > 1e20)
-    return x_unique, y_unique, np.ma.array(grid, mask=invalid)
+    fields = {}
+    for key in field_keys:
+        grid = grids[FIELD_NAME[key]]
+        invalid = (~np.isfinite(grid)) | (np.abs(grid) > 1e20)
+        fields[key] = np.ma.array(grid, mask=invalid)
+    return t, x, y, fields, segments
 
 
 def grid_extent(x: NDArray, y: NDArray) -> list[float]:
@@ -732,7 +1311,8 @@ def mask_field_to_side(field_rz: MaskedArray, r_full: NDArray, side: str) -> Mas
 
 
 def render_frame(
-    frame_path: Path,
+    frame_out: Path | IO[bytes],
+    frame_format: str,
     t: float,
     x: NDArray,
     y: NDArray,
@@ -745,9 +1325,18 @@ def render_frame(
     vel_vmax: float | None,
     left_vmin: float | None,
     left_vmax: float | None,
-) -> None:
+) -> tuple[int, int] | None:
     """
-    Render one PNG frame with full-width vel, left-half scalar overlay, and `f`.
+    Render one frame with full-width vel, left-half scalar overlay, and `f`.
+
+    `frame_out` is a file path or a writable binary stream. With
+    `frame_format="png"` the frame is saved as a tightly cropped PNG. With
+    `"raw"` the whole fixed-size canvas is written as packed `rgb24` rows,
+    so every frame has the same size and needs no image encoding.
+
+    #### Returns
+
+    - `tuple[int, int] | None`: `(width, height)` of a raw frame, `None` for PNG.
     """
     fig, ax = plt.subplots(figsize=(5.8, 10.5), dpi=180)
     r_full, vel_rz = mirror_field_xy_to_rz(vel_field, y)
@@ -824,8 +1413,21 @@ def render_frame(
     cbar_left.ax.yaxis.set_ticks_position("left")
     cbar_left.ax.yaxis.set_label_position("left")
 
-    fig.savefig(frame_path, bbox_inches="tight")
+    if frame_format == "raw":
+        fig.canvas.draw()
+        rgba = np.asarray(fig.canvas.buffer_rgba())
+        height, width = rgba.shape[:2]
+        rgb = np.ascontiguousarray(rgba[..., :3])
+        if isinstance(frame_out, Path):
+            frame_out.write_bytes(rgb.tobytes())
+        else:
+            frame_out.write(rgb.tobytes())
+        plt.close(fig)
+        return width, height
+
+    fig.savefig(frame_out, format="png", bbox_inches="tight")
     plt.close(fig)
+    return None
 
 
 def format_fps(fps: float) -> str:
@@ -859,9 +1461,7 @@ def render_single_snapshot(
     idx: int,
     snapshot: Path,
     case_dir: Path,
-    frames_dir: Path,
-    facet_bin: Path,
-    data_bin: Path,
+    frame_bin: Path | None,
     args: argparse.Namespace,
     left_field_key: str,
     vel_vmin: float | None,
@@ -869,40 +1469,73 @@ def render_single_snapshot(
     left_vmin: float | None,
     left_vmax: float | None,
     worker_cache_root: Path | None,
-) -> tuple[int, Path]:
+) -> tuple[int, bytes, tuple[int, int] | None, bool]:
     """
-    Render one frame for a snapshot and return `(index, frame_path)`.
+    Render one frame for a snapshot and return `(index, data, size, cached)`.
+
+    `data` is a PNG image or a raw `rgb24` canvas of `size = (width, height)`,
+    following `args.frame_format`; `size` is `None` for PNG. With
+    `args.frame_cache`, a frame already rendered from the same snapshot and
+    arguments is returned as is (`cached`), and a new one is stored.
     """
     configure_worker_environment(worker_cache_root)
-    ensure_plotting_runtime()
-
-    t = snapshot_time(snapshot)
 
     xmin = args.xmin
     xmax = args.xmax
     ymin, ymax = sampling_y_bounds_for_window(args.ymin, args.ymax)
 
-    x_vel, y_vel, vel_field = get_field_grid(
-        snapshot, data_bin, case_dir, "vel", xmin, ymin, xmax, ymax, args.ny
-    )
-    x_left, y_left, left_field = get_field_grid(
-        snapshot, data_bin, case_dir, left_field_key, xmin, ymin, xmax, ymax, args.ny
-    )
-    if len(x_vel) != len(x_left) or len(y_vel) != len(y_left):
-        raise RuntimeError("vel/left grids are inconsistent.")
-    if not np.allclose(x_vel, x_left) or not np.allclose(y_vel, y_left):
-        raise RuntimeError("vel/left coordinate arrays are inconsistent.")
+    cache: FrameCache | None = args.frame_cache
+    frame_key: str | None = None
+    if cache is not None:
+        request = frame_request(
+            snapshot, case_dir, ["vel", left_field_key], xmin, ymin, xmax, ymax, args.ny
+        )
+        frame_key = cache.frame_key(
+            cache.grid_key(case_dir, snapshot, request),
+            (
+                args.frame_format,
+                args.xmin,
+                args.xmax,
+                args.ymin,
+                args.ymax,
+                args.vel_cmap,
+                args.left_cmap,
+                left_field_key,
+                vel_vmin,
+                vel_vmax,
+                left_vmin,
+                left_vmax,
+            ),
+        )
+        entry = cache.load(case_dir, "frames", frame_key)
+        if entry is not None and len(entry) >= 8:
+            width, height = struct.unpack_from("<ii", entry)
+            return idx, entry[8:], None if width < 0 else (width, height), True
 
-    interface_segments = get_facets(snapshot, facet_bin, case_dir)
+    ensure_plotting_runtime()
+    t, x, y, fields, interface_segments = get_frame_products(
+        snapshot,
+        frame_bin,
+        case_dir,
+        ["vel", left_field_key],
+        xmin,
+        ymin,
+        xmax,
+        ymax,
+        args.ny,
+        server=None if frame_bin is None else worker_frame_server(frame_bin, case_dir),
+        cache=cache,
+    )
 
-    frame_path = frames_dir / f"frame_{idx:06d}.png"
-    render_frame(
-        frame_path=frame_path,
+    buffer = BytesIO()
+    size = render_frame(
+        frame_out=buffer,
+        frame_format=args.frame_format,
         t=t,
-        x=x_vel,
-        y=y_vel,
-        vel_field=vel_field,
-        left_field=left_field,
+        x=x,
+        y=y,
+        vel_field=fields["vel"],
+        left_field=fields[left_field_key],
         interface_segments=interface_segments,
         args=args,
         left_field_key=left_field_key,
@@ -911,85 +1544,522 @@ def render_single_snapshot(
         left_vmin=left_vmin,
         left_vmax=left_vmax,
     )
-    return idx, frame_path
+    data = buffer.getvalue()
+    if frame_key is not None:
+        assert cache is not None
+        width, height = size if size is not None else (-1, -1)
+        cache.store(case_dir, "frames", frame_key, struct.pack("<ii", width, height) + data)
+    return idx, data, size, False
 
 
-def render_snapshots(
-    snapshots: list[Path],
+class FrameSink:
+    """
+    Consume rendered frames in index order.
+
+    Frames are piped to an `ffmpeg` process reading from `stdin` and/or
+    written as `frame_XXXXXX.png` files, depending on which outputs are
+    configured. `ffmpeg` is started on the first frame, whose size fixes the
+    raw video geometry.
+    """
+
+    def __init__(
+        self,
+        frames_dir: Path | None,
+        ffmpeg: str | None,
+        fps_str: str,
+        out_path: Path,
+    ) -> None:
+        self.frames_dir = frames_dir
+        self.ffmpeg = ffmpeg
+        self.fps_str = fps_str
+        self.out_path = out_path
+        self.size: tuple[int, int] | None = None
+        self.ffmpeg_cmd: list[str] | None = None
+        self.process: subprocess.Popen[bytes] | None = None
+
+    def start(self, size: tuple[int, int] | None) -> None:
+        """
+        Launch `ffmpeg` for PNG input (`size is None`) or raw `rgb24` input.
+        """
+        assert self.ffmpeg is not None
+        if size is None:
+            source = ["-f", "image2pipe", "-framerate", self.fps_str, "-c:v", "png"]
+        else:
+            source = [
+                "-f",
+                "rawvideo",
+                "-pix_fmt",
+                "rgb24",
+                "-s",
+                f"{size[0]}x{size[1]}",
+                "-framerate",
+                self.fps_str,
+            ]
+        # Same encoding as
+        # ffmpeg -framerate <fps> -pattern_type glob -i 'Video/*.png'
+        #   -vf "pad=ceil(iw/2)*2:ceil(ih/2)*2" -c:v libx264 -r <fps> -pix_fmt yuv420p out.mp4
+        # with the frames read from a pipe in render order.
+        self.ffmpeg_cmd = [
+            self.ffmpeg,
+            "-y",
+            *source,
+            "-i",
+            "-",
+            "-vf",
+            "pad=ceil(iw/2)*2:ceil(ih/2)*2",
+            "-c:v",
+            "libx264",
+            "-r",
+            self.fps_str,
+            "-pix_fmt",
+            "yuv420p",
+            str(self.out_path),
+        ]
+        self.size = size
+        self.process = subprocess.Popen(self.ffmpeg_cmd, stdin=subprocess.PIPE)
+
+    def write(self, idx: int, data: bytes, size: tuple[int, int] | None) -> None:
+        """
+        Emit frame `idx`; frames must arrive in increasing index order.
+
+        #### Raises
+
+        - `RuntimeError`: A raw frame's size differs from the first frame's.
+        """
+        if self.frames_dir is not None and size is None:
+            (self.frames_dir / f"frame_{idx:06d}.png").write_bytes(data)
+        if self.ffmpeg is None:
+            return
+        if self.process is None:
+            self.start(size)
+        elif size != self.size:
+            raise RuntimeError(f"Frame {idx} size {size} differs from {self.size}.")
+        assert self.process is not None and self.process.stdin is not None
+        try:
+            self.process.stdin.write(data)
+        except BrokenPipeError:
+            self.close()
+            raise
+
+    def close(self) -> None:
+        """
+        Finish the video stream.
+
+        #### Raises
+
+        - `subprocess.CalledProcessError`: `ffmpeg` exits with a non-zero code.
+        """
+        if self.process is None:
+            return
+        process, self.process = self.process, None
+        assert process.stdin is not None
+        try:
+            process.stdin.close()
+        except BrokenPipeError:
+            pass
+        returncode = process.wait()
+        if returncode != 0:
+            raise subprocess.CalledProcessError(returncode, self.ffmpeg_cmd)
+
+    def abort(self) -> None:
+        """
+        Stop `ffmpeg` without finishing the video.
+        """
+        if self.process is not None:
+            self.process.kill()
+            self.process.wait()
+            self.process = None
+
+
+class CaseSettings(NamedTuple):
+    """
+    Plot window and color limits of one case, resolved from its first
+    snapshot (or in-situ frame).
+    """
+
+    xmin: float
+    xmax: float
+    ymin: float
+    ymax: float
+    vel_vmin: float | None
+    vel_vmax: float | None
+    left_vmin: float | None
+    left_vmax: float | None
+
+
+def auto_color_limits(
+    field: MaskedArray,
+    user_vmin: float | None,
+    user_vmax: float | None,
+    field_key: str,
+) -> tuple[float | None, float | None]:
+    """
+    Resolve the color limits of `field_key`: user values first, then the fixed
+    defaults, then the 2nd/98th percentiles of `field` (its full range when
+    they coincide).
+    """
+    fixed_vmin, fixed_vmax = default_limits_for_field(field_key)
+    need_auto = (user_vmin is None and fixed_vmin is None) or (
+        user_vmax is None and fixed_vmax is None
+    )
+    auto_vmin, auto_vmax = None, None
+    if need_auto:
+        valid = field.compressed()
+        if valid.size:
+            auto_vmin = float(np.percentile(valid, 2.0))
+            auto_vmax = float(np.percentile(valid, 98.0))
+            if (
+                not np.isfinite(auto_vmin)
+                or not np.isfinite(auto_vmax)
+                or auto_vmin == auto_vmax
+            ):
+                auto_vmin = float(np.nanmin(valid))
+                auto_vmax = float(np.nanmax(valid))
+
+    vmin = (
+        user_vmin
+        if user_vmin is not None
+        else (fixed_vmin if fixed_vmin is not None else auto_vmin)
+    )
+    vmax = (
+        user_vmax
+        if user_vmax is not None
+        else (fixed_vmax if fixed_vmax is not None else auto_vmax)
+    )
+    return vmin, vmax
+
+
+def resolve_case_settings(
     case_dir: Path,
-    frames_dir: Path,
-    facet_bin: Path,
-    data_bin: Path,
+    first: Path,
+    facet_bin: Path | None,
+    frame_bin: Path | None,
     args: argparse.Namespace,
     left_field_key: str,
-    vel_vmin: float | None,
-    vel_vmax: float | None,
-    left_vmin: float | None,
-    left_vmax: float | None,
     worker_cache_root: Path | None,
-) -> None:
+) -> CaseSettings:
     """
-    Render all snapshots, batching work in chunks of `args.cpus`.
+    Resolve the plot window and the color limits of one case.
+
+    The window is that of the in-situ frames, or comes from the facets of the
+    first snapshot; automatic color limits come from its first frame. With
+    several cases this runs in a rendering worker, next to the frames of the
+    cases that are already set up.
+
+    #### Raises
+
+    - `ValueError`: The window leaves no physical `y` range to sample.
     """
-    tasks = list(enumerate(snapshots))
-    total = len(tasks)
+    configure_worker_environment(worker_cache_root)
+    ensure_plotting_runtime()
 
-    if args.cpus <= 1:
-        for idx, snapshot in tasks:
-            _, frame_path = render_single_snapshot(
-                idx=idx,
-                snapshot=snapshot,
-                case_dir=case_dir,
-                frames_dir=frames_dir,
-                facet_bin=facet_bin,
-                data_bin=data_bin,
-                args=args,
-                left_field_key=left_field_key,
-                vel_vmin=vel_vmin,
-                vel_vmax=vel_vmax,
-                left_vmin=left_vmin,
-                left_vmax=left_vmax,
-                worker_cache_root=None,
+    case_args = copy.copy(args)
+    if args.insitu:
+        x_in, y_in, _, _ = parse_field_grid(first.read_bytes())
+        dx = x_in[1] - x_in[0] if len(x_in) > 1 else 0.0
+        dy = y_in[1] - y_in[0] if len(y_in) > 1 else 0.0
+        r_hi = float(y_in[-1] + 0.5 * dy)
+        case_args.xmin = float(x_in[0] - 0.5 * dx)
+        case_args.xmax = float(x_in[-1] + 0.5 * dx)
+        case_args.ymin, case_args.ymax = -r_hi, r_hi
+        print(
+            (
+                f"Using in-situ frame window: z in [{case_args.xmin:.6g}, {case_args.xmax:.6g}], "
+                f"r in [{case_args.ymin:.6g}, {case_args.ymax:.6g}]"
+            ),
+            file=sys.stderr,
+        )
+    else:
+        assert facet_bin is not None
+        resolve_window_from_first_snapshot(case_args, first, facet_bin, case_dir)
+
+    sample_ymin, sample_ymax = sampling_y_bounds_for_window(case_args.ymin, case_args.ymax)
+    if sample_ymax <= sample_ymin:
+        raise ValueError("At least one of --ymin/--ymax must be non-zero.")
+
+    _, _, _, fields0, _ = get_frame_products(
+        first,
+        frame_bin,
+        case_dir,
+        ["vel", left_field_key],
+        case_args.xmin,
+        sample_ymin,
+        case_args.xmax,
+        sample_ymax,
+        args.ny,
+        cache=args.frame_cache,
+    )
+
+    if left_field_key == "D2":
+        user_left = (args.d2_vmin, args.d2_vmax)
+    else:
+        user_left = (args.tra_vmin, args.tra_vmax)
+    vel_vmin, vel_vmax = auto_color_limits(
+        fields0["vel"], args.vel_vmin, args.vel_vmax, "vel"
+    )
+    left_vmin, left_vmax = auto_color_limits(
+        fields0[left_field_key], *user_left, left_field_key
+    )
+    return CaseSettings(
+        case_args.xmin,
+        case_args.xmax,
+        case_args.ymin,
+        case_args.ymax,
+        vel_vmin,
+        vel_vmax,
+        left_vmin,
+        left_vmax,
+    )
+
+
+class CaseRender:
+    """
+    One case in the render queue: its snapshots, frame sink, reorder buffer
+    and outcome.
+    """
+
+    def __init__(
+        self,
+        case_dir: Path,
+        snapshots: list[Path],
+        sink: FrameSink,
+        args: argparse.Namespace,
+        frames_dir: Path | None,
+        fps_str: str,
+    ) -> None:
+        self.case_dir = case_dir
+        self.name = case_dir.name
+        self.snapshots = snapshots
+        self.sink = sink
+        self.args = args
+        self.frames_dir = frames_dir
+        self.fps_str = fps_str
+        self.settings: CaseSettings | None = None
+        self.next_submit = 0
+        self.next_emit = 0
+        self.ready: dict[int, tuple[bytes, tuple[int, int] | None, bool]] = {}
+        self.cached = 0
+        self.closing: Future[None] | None = None
+        self.error: BaseException | None = None
+
+    def start(self, settings: CaseSettings) -> None:
+        """
+        Adopt the resolved window and color limits; frames may be submitted.
+        """
+        self.settings = settings
+        self.args = copy.copy(self.args)
+        self.args.xmin = settings.xmin
+        self.args.xmax = settings.xmax
+        self.args.ymin = settings.ymin
+        self.args.ymax = settings.ymax
+
+    def render_arguments(
+        self, frame_bin: Path | None, left_field_key: str, worker_cache_root: Path | None
+    ) -> tuple[Any, ...]:
+        """
+        Arguments of `render_single_snapshot` after the snapshot.
+        """
+        s = self.settings
+        assert s is not None
+        return (
+            self.case_dir,
+            frame_bin,
+            self.args,
+            left_field_key,
+            s.vel_vmin,
+            s.vel_vmax,
+            s.left_vmin,
+            s.left_vmax,
+            worker_cache_root,
+        )
+
+    def emit(
+        self, idx: int, data: bytes, size: tuple[int, int] | None, cached: bool = False
+    ) -> None:
+        """
+        Buffer frame `idx` and hand every frame that is now in order to the sink.
+        """
+        self.ready[idx] = (data, size, cached)
+        total = len(self.snapshots)
+        while self.next_emit in self.ready:
+            data, size, cached = self.ready.pop(self.next_emit)
+            self.sink.write(self.next_emit, data, size)
+            self.cached += cached
+            print(
+                f"[{self.name}] [{self.next_emit + 1}/{total}] "
+                f"{'cached' if cached else 'rendered'} frame {self.next_emit}",
+                file=sys.stderr,
             )
-            print(f"[{idx + 1}/{total}] wrote {frame_path}", file=sys.stderr)
+            self.next_emit += 1
+
+    @property
+    def finished(self) -> bool:
+        """
+        Every frame has reached the sink.
+        """
+        return self.next_emit == len(self.snapshots)
+
+    def fail(self, exc: BaseException) -> None:
+        """
+        Record the first error of the case and drop its video.
+        """
+        if self.error is None:
+            self.error = exc
+        self.ready.clear()
+        self.sink.abort()
+
+
+def render_cases(
+    cases: list[CaseRender],
+    facet_bin: Path | None,
+    frame_bin: Path | None,
+    args: argparse.Namespace,
+    left_field_key: str,
+    worker_cache_root: Path | None,
+) -> None:
+    """
+    Render every case through one pool of `args.cpus` workers.
+
+    The setup of every case (window detection and color limits from its
+    first snapshot) is submitted first, as a pool task. Frames are then
+    submitted in case order, with a sliding window of `2 * args.cpus`
+    frames shared by all cases: a new frame goes out as soon as any frame
+    finishes, and once a case has all its frames in flight the next case
+    fills the pool. Finished frames wait in their case's reorder buffer
+    until every earlier frame of that case is out, bounded by the same
+    window, so one slow snapshot near pinch-off stalls submission only once
+    the window is full.
+
+    When the last frame of a case is written, its `ffmpeg` encode is
+    finished from a separate thread while the other cases keep rendering.
+
+    Errors are recorded per case (`CaseRender.error`) and do not stop the
+    other cases. Each rendering process keeps one `getFrame-elastic --serve`
+    helper, restarted when it moves on to another case; worker helpers
+    exit with their workers.
+    """
+    if args.cpus <= 1:
+        try:
+            for case in cases:
+                try:
+                    case.start(
+                        resolve_case_settings(
+                            case.case_dir,
+                            case.snapshots[0],
+                            facet_bin,
+                            frame_bin,
+                            args,
+                            left_field_key,
+                            None,
+                        )
+                    )
+                    common = case.render_arguments(frame_bin, left_field_key, None)
+                    for idx, snapshot in enumerate(case.snapshots):
+                        case.emit(*render_single_snapshot(idx, snapshot, *common))
+                    case.sink.close()
+                except Exception as exc:  # noqa: BLE001
+                    case.fail(exc)
+        finally:
+            close_worker_frame_server()
         return
 
-    with ProcessPoolExecutor(max_workers=args.cpus) as executor:
-        for start in range(0, total, args.cpus):
-            batch = tasks[start : start + args.cpus]
-            futures = [
-                executor.submit(
-                    render_single_snapshot,
-                    idx,
-                    snapshot,
-                    case_dir,
-                    frames_dir,
+    window = 2 * args.cpus
+    setups: dict[Future[CaseSettings], CaseRender] = {}
+    frames: dict[Future[tuple[int, bytes, tuple[int, int] | None, bool]], CaseRender] = {}
+    with ProcessPoolExecutor(max_workers=args.cpus) as executor, ThreadPoolExecutor(
+        max_workers=len(cases)
+    ) as encoders:
+        try:
+            for case in cases:
+                future = executor.submit(
+                    resolve_case_settings,
+                    case.case_dir,
+                    case.snapshots[0],
                     facet_bin,
-                    data_bin,
+                    frame_bin,
                     args,
                     left_field_key,
-                    vel_vmin,
-                    vel_vmax,
-                    left_vmin,
-                    left_vmax,
                     worker_cache_root,
                 )
-                for idx, snapshot in batch
-            ]
-            batch_results = [future.result() for future in futures]
-            for idx, frame_path in sorted(batch_results, key=lambda item: item[0]):
-                print(f"[{idx + 1}/{total}] wrote {frame_path}", file=sys.stderr)
+                setups[future] = case
+
+            while setups or frames:
+                for case in cases:
+                    if case.settings is None or case.error is not None:
+                        continue
+                    total = len(case.snapshots)
+                    while (
+                        len(frames) < window
+                        and case.next_submit < total
+                        and case.next_submit < case.next_emit + window
+                    ):
+                        idx = case.next_submit
+                        future = executor.submit(
+                            render_single_snapshot,
+                            idx,
+                            case.snapshots[idx],
+                            *case.render_arguments(frame_bin, left_field_key, worker_cache_root),
+                        )
+                        frames[future] = case
+                        case.next_submit += 1
+
+                done, _ = wait([*setups, *frames], return_when=FIRST_COMPLETED)
+                for future in done:
+                    if future in setups:
+                        case = setups.pop(future)
+                        try:
+                            case.start(future.result())
+                        except Exception as exc:  # noqa: BLE001
+                            case.fail(exc)
+                        continue
+
+                    case = frames.pop(future)
+                    if case.error is not None:
+                        continue
+                    try:
+                        case.emit(*future.result())
+                        if case.finished:
+                            case.closing = encoders.submit(case.sink.close)
+                    except Exception as exc:  # noqa: BLE001
+                        case.fail(exc)
+
+            for case in cases:
+                if case.closing is not None:
+                    try:
+                        case.closing.result()
+                    except Exception as exc:  # noqa: BLE001
+                        case.fail(exc)
+        except BaseException:
+            for future in [*setups, *frames]:
+                future.cancel()
+            for case in cases:
+                case.sink.abort()
+            raise
+
+
+def describe_error(exc: BaseException) -> str:
+    """
+    One-line description of a case failure.
+    """
+    if isinstance(exc, subprocess.CalledProcessError):
+        return f"Command failed with exit code {exc.returncode}: {exc.cmd}"
+    return str(exc)
 
 
 def main() -> int:
     """
-    Execute snapshot discovery, frame rendering, and optional MP4 assembly.
+    Execute snapshot discovery, frame rendering, and optional MP4 assembly
+    for one or several cases.
 
     #### Returns
 
-    - `int`: Process exit code (`0` for success, non-zero for errors).
+    - `int`: Process exit code (`0` for success, `1` for invalid arguments,
+      `2` if a helper build or any case failed).
     """
     args = parse_args()
+    use_index = args.snap_glob is None and not args.insitu and not args.no_index
+    if args.snap_glob is None:
+        args.snap_glob = "insitu/frame-*.bin" if args.insitu else "intermediate/snapshot-*"
     left_field_key = "D2" if args.left_d2 else "trA"
 
     if args.vel_cmap is None:
@@ -1013,33 +2083,17 @@ def main() -> int:
 
     explicit_case_dir = args.case_dir is not None
     if explicit_case_dir:
-        case_dir = args.case_dir.resolve()
+        case_dirs = [path.resolve() for path in args.case_dir]
     else:
         cwd = Path.cwd().resolve()
-        case_dir = auto_detect_case_dir(cwd, args.snap_glob)
-        if case_dir != cwd:
-            print(f"Auto-detected case directory: {case_dir}", file=sys.stderr)
+        case_dirs = [auto_detect_case_dir(cwd, args.snap_glob)]
+        if case_dirs[0] != cwd:
+            print(f"Auto-detected case directory: {case_dirs[0]}", file=sys.stderr)
 
     script_dir = Path(__file__).resolve().parent
 
-    snapshots = list_snapshots(case_dir, args.snap_glob)
-    if args.start_time is not None:
-        snapshots = [s for s in snapshots if snapshot_time(s) >= args.start_time]
-    if args.end_time is not None:
-        snapshots = [s for s in snapshots if snapshot_time(s) <= args.end_time]
-    if args.max_frames is not None:
-        snapshots = snapshots[: args.max_frames]
-
-    if not snapshots:
-        hint = ""
-        if explicit_case_dir:
-            hint = " (check --case-dir and --snap-glob)"
-        else:
-            hint = " (you can pass --case-dir simulationCases/<CaseNo>)"
-        print(
-            f"No snapshots found with pattern '{args.snap_glob}' in {case_dir}{hint}",
-            file=sys.stderr,
-        )
+    if args.preview_dt is not None and args.preview_dt <= 0:
+        print("--preview-dt must be > 0", file=sys.stderr)
         return 1
     if args.ny <= 2:
         print("--ny must be > 2", file=sys.stderr)
@@ -1047,241 +2101,167 @@ def main() -> int:
     if args.duration <= 0:
         print("--duration must be > 0", file=sys.stderr)
         return 1
-    sample_ymin: float | None = None
-    sample_ymax: float | None = None
     if args.cpus <= 0:
         print("--cpus must be > 0", file=sys.stderr)
         return 1
     if not args.skip_video and shutil.which(args.ffmpeg) is None:
         print(f"ffmpeg executable not found: {args.ffmpeg}", file=sys.stderr)
         return 1
+    several = len(case_dirs) > 1
+    if several and (
+        Path(args.output).is_absolute()
+        or (args.frames_dir is not None and args.frames_dir.is_absolute())
+    ):
+        print(
+            "--output and --frames-dir must be relative with several --case-dir",
+            file=sys.stderr,
+        )
+        return 1
 
-    out_path = Path(args.output)
-    if not out_path.is_absolute():
-        out_path = case_dir / out_path
-    out_path.parent.mkdir(parents=True, exist_ok=True)
+    if args.skip_video or args.keep_frames:
+        args.frame_format = "png"
 
-    if args.frames_dir is None:
-        frames_dir = case_dir / "Video"
-    else:
-        frames_dir = (
-            args.frames_dir
-            if args.frames_dir.is_absolute()
-            else (case_dir / args.frames_dir)
+    args.frame_cache = None
+    if args.cache_dir is not None:
+        src_local = script_dir.parent / "src-local"
+        args.frame_cache = FrameCache(
+            args.cache_dir,
+            extract_salt=source_digest(
+                [
+                    script_dir / "getFrame-elastic.c",
+                    script_dir / "getFacet.c",
+                    src_local / "elastic-sampling.h",
+                    src_local / "field-grid-io.h",
+                    src_local / "snapshot-io.h",
+                ]
+            ),
+            render_salt=source_digest([Path(__file__).resolve()]),
+        )
+
+    cases: list[CaseRender] = []
+    for case_dir in case_dirs:
+        try:
+            snapshots = select_snapshots(case_dir, args, use_index)
+        except ValueError as exc:
+            print(f"Error: {exc}", file=sys.stderr)
+            return 1
+
+        if not snapshots:
+            hint = ""
+            if explicit_case_dir:
+                hint = " (check --case-dir and --snap-glob)"
+            else:
+                hint = " (you can pass --case-dir simulationCases/<CaseNo>)"
+            print(
+                f"No snapshots found with pattern '{args.snap_glob}' in {case_dir}{hint}",
+                file=sys.stderr,
+            )
+            if several:
+                continue
+            return 1
+
+        out_path = Path(args.output)
+        if not out_path.is_absolute():
+            out_path = case_dir / out_path
+        out_path.parent.mkdir(parents=True, exist_ok=True)
+
+        frames_dir: Path | None = None
+        if args.skip_video or args.keep_frames:
+            if args.frames_dir is None:
+                frames_dir = case_dir / "Video"
+            else:
+                frames_dir = (
+                    args.frames_dir
+                    if args.frames_dir.is_absolute()
+                    else (case_dir / args.frames_dir)
+                )
+            frames_dir.mkdir(parents=True, exist_ok=True)
+
+            if args.clean_frames:
+                for old_png in frames_dir.glob("*.png"):
+                    old_png.unlink()
+
+        fps = (
+            float(args.fps)
+            if args.fps is not None
+            else (len(snapshots) / args.duration)
         )
-    frames_dir.mkdir(parents=True, exist_ok=True)
+        fps = max(1e-6, fps)
+        fps_str = format_fps(fps)
 
-    if args.clean_frames:
-        for old_png in frames_dir.glob("*.png"):
-            old_png.unlink()
+        sink = FrameSink(
+            frames_dir, None if args.skip_video else args.ffmpeg, fps_str, out_path
+        )
+        cases.append(CaseRender(case_dir, snapshots, sink, args, frames_dir, fps_str))
+
+    if not cases:
+        print("No case with snapshots to render.", file=sys.stderr)
+        return 1
 
     temp_objects: list[tempfile.TemporaryDirectory[str]] = []
-    temp_build = tempfile.TemporaryDirectory(prefix="video-film-tools-", dir=case_dir)
+    temp_root = cases[0].case_dir
+    temp_build = tempfile.TemporaryDirectory(prefix="video-film-tools-", dir=temp_root)
     temp_objects.append(temp_build)
     build_dir = Path(temp_build.name)
     worker_cache_root: Path | None = None
     if args.cpus > 1:
         temp_worker_cache = tempfile.TemporaryDirectory(
-            prefix="video-film-worker-cache-", dir=case_dir
+            prefix="video-film-worker-cache-", dir=temp_root
         )
         temp_objects.append(temp_worker_cache)
         worker_cache_root = Path(temp_worker_cache.name)
 
     try:
-        print("Pre-processing: compiling get* helpers...", file=sys.stderr)
-        facet_bin, data_bin = precompile_get_helpers(script_dir, build_dir)
-
-        first_facets = get_facets(snapshots[0], facet_bin, case_dir)
-        (
-            args.xmin,
-            args.xmax,
-            args.ymin,
-            args.ymax,
-        ) = resolve_plot_window_from_facets(
-            interface_segments=first_facets,
-            xmin=args.xmin,
-            xmax=args.xmax,
-            ymin=args.ymin,
-            ymax=args.ymax,
-        )
-        print(
-            (
-                f"Using plot window: z in [{args.xmin:.6g}, {args.xmax:.6g}], "
-                f"r in [{args.ymin:.6g}, {args.ymax:.6g}]"
-            ),
-            file=sys.stderr,
-        )
-        sample_ymin, sample_ymax = sampling_y_bounds_for_window(args.ymin, args.ymax)
-        if sample_ymax <= sample_ymin:
-            raise ValueError("At least one of --ymin/--ymax must be non-zero.")
-
-        _, _, vel0 = get_field_grid(
-            snapshots[0],
-            data_bin,
-            case_dir,
-            "vel",
-            args.xmin,
-            sample_ymin,
-            args.xmax,
-            sample_ymax,
-            args.ny,
-        )
-        _, _, left0 = get_field_grid(
-            snapshots[0],
-            data_bin,
-            case_dir,
-            left_field_key,
-            args.xmin,
-            sample_ymin,
-            args.xmax,
-            sample_ymax,
-            args.ny,
-        )
-
-        fixed_vel_vmin, fixed_vel_vmax = default_limits_for_field("vel")
-        need_auto_vel = (args.vel_vmin is None and fixed_vel_vmin is None) or (
-            args.vel_vmax is None and fixed_vel_vmax is None
-        )
-        auto_vel_vmin, auto_vel_vmax = None, None
-        if need_auto_vel:
-            valid_vel0 = vel0.compressed()
-            if valid_vel0.size:
-                auto_vel_vmin = float(np.percentile(valid_vel0, 2.0))
-                auto_vel_vmax = float(np.percentile(valid_vel0, 98.0))
-                if (
-                    not np.isfinite(auto_vel_vmin)
-                    or not np.isfinite(auto_vel_vmax)
-                    or auto_vel_vmin == auto_vel_vmax
-                ):
-                    auto_vel_vmin = float(np.nanmin(valid_vel0))
-                    auto_vel_vmax = float(np.nanmax(valid_vel0))
-
-        use_vel_vmin = (
-            args.vel_vmin
-            if args.vel_vmin is not None
-            else (
-                fixed_vel_vmin
-                if fixed_vel_vmin is not None
-                else auto_vel_vmin
-            )
-        )
-        use_vel_vmax = (
-            args.vel_vmax
-            if args.vel_vmax is not None
-            else (
-                fixed_vel_vmax
-                if fixed_vel_vmax is not None
-                else auto_vel_vmax
-            )
-        )
-
-        user_left_vmin: float | None
-        user_left_vmax: float | None
-        if left_field_key == "D2":
-            user_left_vmin = args.d2_vmin
-            user_left_vmax = args.d2_vmax
-        else:
-            user_left_vmin = args.tra_vmin
-            user_left_vmax = args.tra_vmax
-
-        fixed_left_vmin, fixed_left_vmax = default_limits_for_field(left_field_key)
-        need_auto_left = (user_left_vmin is None and fixed_left_vmin is None) or (
-            user_left_vmax is None and fixed_left_vmax is None
-        )
-        auto_left_vmin, auto_left_vmax = None, None
-        if need_auto_left:
-            valid_left0 = left0.compressed()
-            if valid_left0.size:
-                auto_left_vmin = float(np.percentile(valid_left0, 2.0))
-                auto_left_vmax = float(np.percentile(valid_left0, 98.0))
-                if (
-                    not np.isfinite(auto_left_vmin)
-                    or not np.isfinite(auto_left_vmax)
-                    or auto_left_vmin == auto_left_vmax
-                ):
-                    auto_left_vmin = float(np.nanmin(valid_left0))
-                    auto_left_vmax = float(np.nanmax(valid_left0))
-
-        use_left_vmin = (
-            user_left_vmin
-            if user_left_vmin is not None
-            else (
-                fixed_left_vmin
-                if fixed_left_vmin is not None
-                else auto_left_vmin
-            )
-        )
-        use_left_vmax = (
-            user_left_vmax
-            if user_left_vmax is not None
-            else (
-                fixed_left_vmax
-                if fixed_left_vmax is not None
-                else auto_left_vmax
-            )
-        )
-
-        render_snapshots(
-            snapshots=snapshots,
-            case_dir=case_dir,
-            frames_dir=frames_dir,
+        facet_bin: Path | None = None
+        frame_bin: Path | None = None
+        if not args.insitu:
+            # One build serves every case of this run; with a cache, every
+            # later run with the same helper sources too.
+            cache = args.frame_cache
+            bin_dir = build_dir
+            if cache is not None:
+                bin_dir = cache.directory(cases[0].case_dir) / "bin" / cache.extract_salt[:16]
+            facet_bin = bin_dir / "getFacet"
+            frame_bin = bin_dir / "getFrame-elastic"
+            if not (facet_bin.exists() and frame_bin.exists()):
+                print("Pre-processing: compiling get* helpers...", file=sys.stderr)
+                built = precompile_get_helpers(script_dir, build_dir)
+                if bin_dir != build_dir:
+                    # Move complete binaries only, so an interrupted build is redone.
+                    bin_dir.mkdir(parents=True, exist_ok=True)
+                    for src, dst in zip(built, (facet_bin, frame_bin)):
+                        tmp = dst.with_name(f"{dst.name}.tmp{os.getpid()}")
+                        shutil.copy2(src, tmp)
+                        os.replace(tmp, dst)
+
+        render_cases(
+            cases=cases,
             facet_bin=facet_bin,
-            data_bin=data_bin,
+            frame_bin=frame_bin,
             args=args,
             left_field_key=left_field_key,
-            vel_vmin=use_vel_vmin,
-            vel_vmax=use_vel_vmax,
-            left_vmin=use_left_vmin,
-            left_vmax=use_left_vmax,
             worker_cache_root=worker_cache_root,
         )
 
-        if args.skip_video:
-            print(f"Frames written to: {frames_dir}", file=sys.stderr)
-            return 0
-
-        fps = (
-            float(args.fps)
-            if args.fps is not None
-            else (len(snapshots) / args.duration)
-        )
-        fps = max(1e-6, fps)
-        fps_str = format_fps(fps)
-
-        # Matches requested ffmpeg style:
-        # ffmpeg -framerate <fps> -pattern_type glob -i 'Video/*.png'
-        #   -vf "pad=ceil(iw/2)*2:ceil(ih/2)*2" -c:v libx264 -r <fps> -pix_fmt yuv420p out.mp4
-        cmd = [
-            args.ffmpeg,
-            "-y",
-            "-framerate",
-            fps_str,
-            "-pattern_type",
-            "glob",
-            "-i",
-            str(frames_dir / "*.png"),
-            "-vf",
-            "pad=ceil(iw/2)*2:ceil(ih/2)*2",
-            "-c:v",
-            "libx264",
-            "-r",
-            fps_str,
-            "-pix_fmt",
-            "yuv420p",
-            str(out_path),
-        ]
-        subprocess.run(cmd, check=True)
-        print(
-            f"Wrote video: {out_path} | fps={fps_str} | frames={len(snapshots)} | duration~{args.duration}s",
-            file=sys.stderr,
-        )
-        return 0
+        failed = 0
+        for case in cases:
+            if case.error is not None:
+                failed += 1
+                print(f"[{case.name}] Error: {describe_error(case.error)}", file=sys.stderr)
+                continue
+            if case.frames_dir is not None:
+                print(f"[{case.name}] Frames written to: {case.frames_dir}", file=sys.stderr)
+            if not args.skip_video:
+                print(
+                    f"[{case.name}] Wrote video: {case.sink.out_path} | fps={case.fps_str} "
+                    f"| frames={len(case.snapshots)} | cached={case.cached} "
+                    f"| duration~{args.duration}s",
+                    file=sys.stderr,
+                )
+        return 2 if failed else 0
 
     except subprocess.CalledProcessError as exc:
-        print(
-            f"Command failed with exit code {exc.returncode}: {exc.cmd}",
-            file=sys.stderr,
-        )
+        print(describe_error(exc), file=sys.stderr)
         return 2
     except Exception as exc:  # noqa: BLE001
         print(f"Error: {exc}", file=sys.stderr)
@@ -7,7 +7,8 @@ pointwise values for downstream plotting scripts.
 ## Purpose
 
 Convert adaptive-grid fields into a uniform sampling table over a rectangular
-window. The output is written to `stderr` as plain whitespace-separated columns.
+window. The output is written as plain whitespace-separated columns or as
+binary column arrays, optionally restricted to a subset of the fields.
 
 ## Computed Fields
 
@@ -17,19 +18,38 @@ window. The output is written to `stderr` as plain whitespace-separated columns.
 - `trA`: $\log_{10}\left(\mathrm{tr}(\mathbf{A})/3\right)$ where
   $\mathrm{tr}(\mathbf{A}) = A_{xx} + A_{yy} + A_{\theta\theta}$
 
-## Output Columns
+## Output Formats
 
-`x y D2c vel trA`
+- `text` (default): whitespace-separated rows `x y <fields...>` on `stderr`,
+  with the default fields giving `x y D2c vel trA`.
+- `float32`/`float64`: the binary column container described in
+  `src-local/field-grid-io.h` (header with `nx`, `ny`, bounds and field
+  names, then one raw array per field), written to `stdout` by default.
+
+With `--adaptive`, the leaves overlapping the window are written at their
+native resolution instead of being resampled: text rows `x y Delta
+<fields...>`, or the `EPOCELL1` cell container of `field-grid-io.h` for
+binary formats. `ny` is still required but unused in this mode.
+
+## Sampling
+
+Uniform output is filled by `elastic_sample_window()`, which walks the
+leaves once and evaluates every sample point inside each leaf, instead of
+locating each point from the root. `--sampler=locate` selects the
+original per-point `interpolate()` loop for cross-checking.
 
 ## Build Example
 
 ```bash
-qcc -Wall -O2 -disable-dimensions postProcess/getData-elastic-nonCoalescence.c -o getData -lm
+qcc -Wall -O2 -disable-dimensions -Isrc-local postProcess/getData-elastic.c -o getData -lm
 ```
 */
 
 #include "utils.h"
 #include "output.h"
+#include "fractions.h"
+#include "field-grid-io.h"
+#include "snapshot-io.h"
 
 scalar f[];
 vector u[];
@@ -44,28 +64,42 @@ double xmin, ymin, xmax, ymax, Deltax, Deltay;
 scalar D2c[], vel[], trA[];
 scalar * list = NULL;
 
+#include "elastic-sampling.h"
+
 /**
 ## main()
 
 Usage:
-`./getData-elastic-nonCoalescence snapshot xmin ymin xmax ymax ny [Oh1 Oh2 Oh3]`
+`./getData-elastic snapshot xmin ymin xmax ymax ny [Oh1 Oh2 Oh3] [options]`
 
 #### Arguments
 
-- `snapshot`: Basilisk dump/snapshot file to restore.
+- `snapshot`: Basilisk dump/snapshot file to restore (plain, `.gz` or `.zst`).
 - `xmin ymin xmax ymax`: sampling rectangle bounds in simulation coordinates.
 - `ny`: number of points along the `y` direction.
 - `Oh1 Oh2 Oh3`: accepted for CLI compatibility (not used in this utility).
 
+#### Options
+
+- `--fields=LIST`: comma-separated subset of `D2c,vel,trA` to compute and
+  emit (default: all three).
+- `--format=FMT`: `text` (default), `float32` or `float64`.
+- `--out=PATH`: output file; `-` means `stdout`. Defaults to `stderr` for
+  `text` and `stdout` for binary formats.
+- `--adaptive`: write the leaves in the window at native resolution.
+- `--sampler=leaf|locate`: uniform sampling engine (default: `leaf`).
+
 #### Returns
 
-`0` after writing sampled rows to `stderr`.
+`0` after writing the sampled fields, `1` on invalid arguments or I/O errors.
 */
 int main(int a, char const *arguments[])
 {
   if (a < 7) {
     fprintf(ferr,
-            "Usage: %s snapshot xmin ymin xmax ymax ny [Oh1 Oh2 Oh3]\n",
+            "Usage: %s snapshot xmin ymin xmax ymax ny [Oh1 Oh2 Oh3]"
+            " [--fields=D2c,vel,trA] [--format=text|float32|float64]"
+            " [--out=PATH] [--adaptive] [--sampler=leaf|locate]\n",
             arguments[0]);
     return 1;
   }
@@ -75,74 +109,133 @@ int main(int a, char const *arguments[])
   xmax = atof(arguments[4]); ymax = atof(arguments[5]);
   ny = atoi(arguments[6]);
 
-  list = list_add (list, D2c);
-  list = list_add (list, vel);
-  list = list_add (list, trA);
-
-  /**
-  Restore the snapshot and evaluate derived fields on cell centers.
-  */
-  restore (file = filename);
-
-  foreach() {
-    double D11 = (u.y[0,1] - u.y[0,-1])/(2*Delta);
-    double D22 = (fabs(y) > 1e-14 ? u.y[]/y : 0.);
-    double D33 = (u.x[1,0] - u.x[-1,0])/(2*Delta);
-    double D13 = 0.5*( (u.y[1,0] - u.y[-1,0] + u.x[0,1] - u.x[0,-1])/(2*Delta) );
-    double D_contract = (sq(D11)+sq(D22)+sq(D33)+2.0*sq(D13));
-    D2c[] = sqrt(0.5*D_contract);
-
-    if (D2c[] > 0.){
-      D2c[] = log(D2c[])/log(10);
-    } else {
-      D2c[] = -10;
+  int selected[ELASTIC_NFIELDS] = {0, 1, 2}, nselected = ELASTIC_NFIELDS;
+  int value_bytes = 0; // 0: text
+  const char * out = NULL;
+  bool adaptive = false, located = false;
+  for (int k = 7; k < a; k++) {
+    if (!strncmp (arguments[k], "--fields=", 9)) {
+      nselected = elastic_parse_fields (arguments[k] + 9, selected);
+      if (nselected <= 0) {
+        fprintf (ferr, "ERROR: invalid field list '%s'\n", arguments[k] + 9);
+        return 1;
+      }
+    }
+    else if (!strcmp (arguments[k], "--format=text"))
+      value_bytes = 0;
+    else if (!strcmp (arguments[k], "--format=float32"))
+      value_bytes = 4;
+    else if (!strcmp (arguments[k], "--format=float64"))
+      value_bytes = 8;
+    else if (!strncmp (arguments[k], "--out=", 6))
+      out = arguments[k] + 6;
+    else if (!strcmp (arguments[k], "--adaptive"))
+      adaptive = true;
+    else if (!strcmp (arguments[k], "--sampler=leaf"))
+      located = false;
+    else if (!strcmp (arguments[k], "--sampler=locate"))
+      located = true;
+    else if (!strncmp (arguments[k], "--", 2)) {
+      fprintf (ferr, "ERROR: unknown option '%s'\n", arguments[k]);
+      return 1;
     }
+  }
 
-    vel[] = sqrt(sq(u.x[])+sq(u.y[]));
+  if (ny <= 0 || xmax <= xmin || ymax <= ymin) {
+    fprintf (ferr, "ERROR: invalid sampling window or ny\n");
+    return 1;
+  }
 
-    trA[] = (A11[] + A22[]+AThTh[])/3.0;
+  bool want[ELASTIC_NFIELDS] = {false};
+  for (int k = 0; k < nselected; k++)
+    want[selected[k]] = true;
 
-    if (trA[] > 0.){
-      trA[] = log(trA[])/log(10);
-    } else {
-      trA[] = -10;
-     }
+  scalar fields[ELASTIC_NFIELDS] = {D2c, vel, trA};
+  for (int k = 0; k < nselected; k++)
+    list = list_add (list, fields[selected[k]]);
 
+  /**
+  Restore the snapshot and evaluate the requested derived fields on cell
+  centers.
+  */
+  if (!snapshot_restore (filename, NULL)) {
+    fprintf (ferr, "ERROR: cannot restore %s\n", filename);
+    return 1;
   }
+  elastic_derived_fields (D2c, vel, trA, want);
 
-  FILE * fp = ferr;
   Deltay = (double)((ymax-ymin)/(ny));
   nx = (int)((xmax - xmin)/Deltay);
   Deltax = (double)((xmax-xmin)/(nx));
   len = list_len(list);
   /**
-  Interpolate all diagnostics onto a uniform `nx x ny` sampling grid.
+  Interpolate the requested diagnostics onto a uniform `nx x ny` sampling
+  grid. Each field is stored as one contiguous column of `nx*ny` values,
+  row by row in `y`. In adaptive mode, gather the leaves instead.
   */
-  double ** field = (double **) matrix_new (nx, ny+1, len*sizeof(double));
-  for (int i = 0; i < nx; i++) {
-    double x = Deltax*(i+1./2) + xmin;
-    for (int j = 0; j < ny; j++) {
-      double y = Deltay*(j+1./2) + ymin;
-      int k = 0;
-      for (scalar s in list){
-        field[i][len*j + k++] = interpolate (s, x, y);
-      }
-    }
+  double * field = NULL;
+  long ncells = 0;
+  if (adaptive)
+    field = elastic_collect_cells (list, xmin, ymin, xmax, ymax, &ncells);
+  else {
+    field = (double *) malloc ((size_t) len*nx*ny*sizeof(double));
+    if (located)
+      elastic_sample_window_located (list, xmin, ymin, xmax, ymax, nx, ny, field);
+    else
+      elastic_sample_window (list, xmin, ymin, xmax, ymax, nx, ny, field);
   }
 
-  for (int i = 0; i < nx; i++) {
-    double x = Deltax*(i+1./2) + xmin;
-    for (int j = 0; j < ny; j++) {
-      double y = Deltay*(j+1./2) + ymin;
-      fprintf (fp, "%g %g", x, y);
-      int k = 0;
-      for (scalar s in list){
-        fprintf (fp, " %g", field[i][len*j + k++]);
-      }
+  FILE * fp = NULL;
+  if (out && strcmp (out, "-"))
+    fp = fopen (out, value_bytes ? "wb" : "w");
+  else if (out || value_bytes)
+    fp = stdout;
+  else
+    fp = ferr;
+  if (!fp) {
+    fprintf (ferr, "ERROR: cannot open output file %s\n", out);
+    free (field);
+    return 1;
+  }
+
+  int status = 0;
+  const char * names[ELASTIC_NFIELDS];
+  for (int k = 0; k < len; k++)
+    names[k] = elastic_field_names[selected[k]];
+  if (adaptive && value_bytes)
+    status = field_cells_write (fp, names, len, value_bytes, field, ncells);
+  else if (adaptive) {
+    for (long c = 0; c < ncells; c++) {
+      fprintf (fp, "%g %g %g", field[c], field[ncells + c], field[2*ncells + c]);
+      for (int k = 0; k < len; k++)
+        fprintf (fp, " %g", field[(3 + k)*ncells + c]);
       fputc ('\n', fp);
     }
   }
+  else if (value_bytes) {
+    status = field_grid_write_header (fp, nx, ny, names, len, value_bytes,
+                                      xmin, ymin, xmax, ymax);
+    for (int k = 0; k < len && !status; k++)
+      status = field_grid_write_column (fp, field + (long) k*nx*ny,
+                                        (long) nx*ny, 1, value_bytes);
+  }
+  else {
+    for (int i = 0; i < nx; i++) {
+      double x = Deltax*(i+1./2) + xmin;
+      for (int j = 0; j < ny; j++) {
+        double y = Deltay*(j+1./2) + ymin;
+        fprintf (fp, "%g %g", x, y);
+        for (int k = 0; k < len; k++)
+          fprintf (fp, " %g", field[((long) k*ny + j)*nx + i]);
+        fputc ('\n', fp);
+      }
+    }
+  }
   fflush (fp);
-  fclose (fp);
-  matrix_free (field);
+  if (fp != stdout)
+    fclose (fp);
+  free (field);
+  if (status)
+    fprintf (ferr, "ERROR: failed to write sampled fields\n");
+  return status ? 1 : 0;
 }
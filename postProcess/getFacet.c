@@ -11,13 +11,14 @@ The output is written to `stderr` in Basilisk's facet text format.
 ## Build Example
 
 ```bash
-qcc -Wall -O2 postProcess/getFacet.c -o getFacet -lm
+qcc -Wall -O2 -Isrc-local postProcess/getFacet.c -o getFacet -lm
 ```
 */
 
 #include "utils.h"
 #include "output.h"
 #include "fractions.h"
+#include "snapshot-io.h"
 
 scalar f[];
 char filename[80];
@@ -29,7 +30,7 @@ Usage:
 `./getFacet snapshot`
 #### Arguments
 
-- `snapshot`: Basilisk dump/snapshot file to restore.
+- `snapshot`: Basilisk dump/snapshot file to restore (plain, `.gz` or `.zst`).
 
 #### Returns
 
@@ -42,7 +43,10 @@ int main(int a, char const *arguments[]){
   }
 
   sprintf(filename, "%s", arguments[1]);
-  restore (file = filename);
+  if (!snapshot_restore (filename, NULL)) {
+    fprintf(ferr, "ERROR: cannot restore %s\n", filename);
+    return 1;
+  }
 
   FILE * fp = ferr;
   output_facets(f,fp);
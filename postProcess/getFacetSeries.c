@@ -0,0 +1,430 @@
+/**
+# getFacetSeries.c
+
+Extract the neck radius and the interface of many snapshots in one
+process.
+
+## Purpose
+
+`getFacet.c` restores one snapshot per process launch, and its
+`output_facets` text must then be parsed. For an `h_min(t)` curve or the
+interface shapes of a whole case, this helper walks a list of snapshots
+(by default the `intermediate/snapshots.index` of the case) and, for each,
+restores `f` into the same process and field list and measures the `f`
+interface from its facets:
+
+- `hmin`: minimum interface radius, the lowest facet end point;
+- `x_hmin`: axial position of that point;
+- `length`: total facet length in the `(x, y)` plane;
+- `segments`: number of facets.
+
+## Output
+
+- A CSV table, to `stdout` by default, in snapshot order:
+  `file,t,hmin,x_hmin,length,segments`. Snapshots without interface have
+  empty `hmin`, `x_hmin`.
+- With `--facets=PATH`, the segments of every row, as consecutive facet
+  sections (`EPOFACE1`, time and `(x0, y0, x1, y1)` quadruplets, see
+  `src-local/field-grid-io.h`) in the order of the table.
+
+A snapshot that cannot be restored is reported on `stderr` and left out;
+the others are still processed.
+
+## Parallel Extraction
+
+Basilisk keeps a single grid per process, so OpenMP threads cannot each
+restore their own snapshot. With `--jobs=N`, the helper forks `N`
+workers instead; worker `w` restores every `N`-th snapshot into its own
+grid and spools its rows to a temporary file, which the parent merges in
+snapshot order.
+
+## Build Example
+
+```bash
+qcc -Wall -O2 -Isrc-local postProcess/getFacetSeries.c -o getFacetSeries -lm
+cd simulationCases/1000
+../../getFacetSeries --facets=facets.bin > interface-series.csv
+```
+*/
+
+#include "utils.h"
+#include "output.h"
+#include "fractions.h"
+#include "field-grid-io.h"
+#include "snapshot-io.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+scalar f[];
+
+/**
+## Snapshot Lists
+
+Entries are read from the snapshot index (last row per file, sorted by
+time), from a list file (one path per line) or from the command line. */
+
+typedef struct {
+  char file[256];
+  double t;
+} SeriesEntry;
+
+static SeriesEntry * entries = NULL;
+static int nentries = 0, entries_size = 0;
+
+static void entry_add (const char * file, double t)
+{
+  for (int k = 0; k < nentries; k++)
+    if (!strcmp (entries[k].file, file)) {
+      entries[k].t = t;
+      return;
+    }
+  if (nentries == entries_size) {
+    entries_size = entries_size ? 2*entries_size : 256;
+    entries = (SeriesEntry *) realloc (entries,
+                                       entries_size*sizeof(SeriesEntry));
+  }
+  snprintf (entries[nentries].file, sizeof(entries[nentries].file), "%s",
+            file);
+  entries[nentries++].t = t;
+}
+
+static int entry_compare (const void * a, const void * b)
+{
+  double ta = ((const SeriesEntry *) a)->t, tb = ((const SeriesEntry *) b)->t;
+  return ta < tb ? -1 : ta > tb;
+}
+
+/**
+### read_index()
+
+#### Returns
+- `0` on success, `1` if `index` cannot be read.
+*/
+static int read_index (const char * index)
+{
+  FILE * fp = fopen (index, "r");
+  if (!fp) {
+    fprintf (ferr, "ERROR: cannot read snapshot index %s\n", index);
+    return 1;
+  }
+  char line[512], file[256];
+  double ts, hm;
+  int it, level;
+  long bytes;
+  while (fgets (line, sizeof(line), fp))
+    if (line[0] != '#' &&
+        sscanf (line, "%255s %lf %d %ld %lf %d", file, &ts, &it, &bytes, &hm,
+                &level) == 6)
+      entry_add (file, ts);
+  fclose (fp);
+  qsort (entries, nentries, sizeof(SeriesEntry), entry_compare);
+  return 0;
+}
+
+/**
+### read_list()
+
+#### Returns
+- `0` on success, `1` if `list` cannot be read.
+*/
+static int read_list (const char * list)
+{
+  FILE * fp = fopen (list, "r");
+  if (!fp) {
+    fprintf (ferr, "ERROR: cannot read snapshot list %s\n", list);
+    return 1;
+  }
+  char line[512], file[256];
+  while (fgets (line, sizeof(line), fp))
+    if (sscanf (line, "%255s", file) == 1 && file[0] != '#')
+      entry_add (file, -1.);
+  fclose (fp);
+  return 0;
+}
+
+/**
+## Interface Measurements
+
+One row of the table. `nseg` segments follow the row in the worker
+spool files. */
+
+typedef struct {
+  int index, status;
+  double t, hmin, x_hmin, length;
+  long nseg;
+} SeriesRow;
+
+/**
+### measure_snapshot()
+
+Restores `file` and fills `row` with the measurements of its `f`
+interface. `seg` is grown as needed and holds the `4*row->nseg`
+coordinates of the facets.
+
+#### Returns
+- `0` on success, `1` if the snapshot cannot be restored.
+*/
+static int measure_snapshot (const char * file, SeriesRow * row,
+                             double ** seg, long * size)
+{
+  row->status = 1;
+  row->nseg = 0;
+  if (!snapshot_restore (file, NULL)) {
+    fprintf (ferr, "ERROR: cannot restore %s\n", file);
+    return 1;
+  }
+
+  long count = 0;
+  double hmin = HUGE, x_hmin = 0., length = 0.;
+  foreach (serial)
+    if (f[] > 1e-6 && f[] < 1. - 1e-6) {
+      coord n = interface_normal (point, f);
+      double alpha = plane_alpha (f[], n);
+      coord segment[2];
+      if (facets (n, alpha, segment) == 2) {
+        if (count == *size) {
+          *size = *size ? 2*(*size) : 1024;
+          *seg = (double *) realloc (*seg, 4*(*size)*sizeof(double));
+        }
+        double * s = *seg + 4*count;
+        s[0] = x + segment[0].x*Delta, s[1] = y + segment[0].y*Delta;
+        s[2] = x + segment[1].x*Delta, s[3] = y + segment[1].y*Delta;
+        length += sqrt (sq(s[2] - s[0]) + sq(s[3] - s[1]));
+        for (int e = 0; e < 2; e++)
+          if (s[2*e + 1] < hmin)
+            hmin = s[2*e + 1], x_hmin = s[2*e];
+        count++;
+      }
+    }
+
+  row->status = 0;
+  row->t = t;
+  row->hmin = hmin;
+  row->x_hmin = x_hmin;
+  row->length = length;
+  row->nseg = count;
+  return 0;
+}
+
+/**
+### emit_row()
+
+Writes one table row and, with `facets`, its facet section.
+
+#### Returns
+- `0` on success, `1` on a write error.
+*/
+static int emit_row (FILE * csv, FILE * facets, const SeriesRow * row,
+                     const double * seg)
+{
+  const char * file = entries[row->index].file;
+  if (row->nseg > 0)
+    fprintf (csv, "%s,%.17g,%.10g,%.10g,%.10g,%ld\n", file, row->t,
+             row->hmin, row->x_hmin, row->length, row->nseg);
+  else
+    fprintf (csv, "%s,%.17g,,,0,0\n", file, row->t);
+  if (facets && field_grid_write_facets (facets, row->t, seg, row->nseg))
+    return 1;
+  return ferror (csv) ? 1 : 0;
+}
+
+/**
+### run_worker()
+
+Measures the snapshots `first`, `first + stride`, ... and either emits
+their rows directly (`spool == NULL`) or appends them, with their facets,
+to `spool` for the parent.
+
+#### Returns
+- `0` if every snapshot was measured and written, `1` otherwise.
+*/
+static int run_worker (int first, int stride, FILE * spool, FILE * csv,
+                       FILE * facets)
+{
+  double * seg = NULL;
+  long size = 0;
+  int status = 0;
+  for (int k = first; k < nentries; k += stride) {
+    SeriesRow row = {.index = k};
+    if (measure_snapshot (entries[k].file, &row, &seg, &size))
+      status = 1;
+    if (spool) {
+      if (fwrite (&row, sizeof(row), 1, spool) != 1 ||
+          (row.nseg > 0 &&
+           fwrite (seg, sizeof(double), 4*row.nseg, spool) !=
+           (size_t) (4*row.nseg))) {
+        status = 1;
+        break;
+      }
+    }
+    else if (!row.status && emit_row (csv, facets, &row, seg)) {
+      fprintf (ferr, "ERROR: failed to write the interface series\n");
+      status = 1;
+      break;
+    }
+  }
+  if (spool)
+    fflush (spool);
+  free (seg);
+  return status;
+}
+
+/**
+### run_jobs()
+
+Forks `jobs` workers, each with its own spool file, then merges their rows
+in snapshot order. Worker `w` handles snapshots `w`, `w + jobs`, ..., so
+row `k` is the next record of spool `k % jobs`.
+
+#### Returns
+- `0` on success, `1` if a worker or a write failed.
+*/
+static int run_jobs (int jobs, FILE * csv, FILE * facets)
+{
+  FILE ** spool = (FILE **) calloc (jobs, sizeof(FILE *));
+  pid_t * workers = (pid_t *) calloc (jobs, sizeof(pid_t));
+  int status = 0, started = 0;
+  fflush (csv);
+  if (facets)
+    fflush (facets);
+  for (; started < jobs; started++) {
+    int w = started;
+    if (!(spool[w] = tmpfile()) || (workers[w] = fork()) < 0) {
+      fprintf (ferr, "ERROR: cannot start worker %d\n", w);
+      if (spool[w])
+        fclose (spool[w]);
+      status = 1;
+      break;
+    }
+    if (workers[w] == 0)
+      _exit (run_worker (w, jobs, spool[w], NULL, NULL));
+  }
+
+  for (int w = 0; w < started; w++) {
+    int ws;
+    if (waitpid (workers[w], &ws, 0) < 0 || !WIFEXITED(ws) ||
+        WEXITSTATUS(ws))
+      status = 1;
+    rewind (spool[w]);
+  }
+
+  // Without every worker, the rows cannot be merged in order.
+  double * seg = NULL;
+  long size = 0;
+  for (int k = 0; k < nentries && started == jobs; k++) {
+    SeriesRow row;
+    FILE * fp = spool[k % jobs];
+    if (fread (&row, sizeof(row), 1, fp) != 1 || row.index != k)
+      break; // worker stopped early, already reported
+    if (row.nseg > size) {
+      size = row.nseg;
+      seg = (double *) realloc (seg, 4*size*sizeof(double));
+    }
+    if (row.nseg > 0 &&
+        fread (seg, sizeof(double), 4*row.nseg, fp) != (size_t) (4*row.nseg))
+      break;
+    if (!row.status && emit_row (csv, facets, &row, seg)) {
+      fprintf (ferr, "ERROR: failed to write the interface series\n");
+      status = 1;
+      break;
+    }
+  }
+
+  for (int w = 0; w < started; w++)
+    fclose (spool[w]);
+  free (seg);
+  free (spool);
+  free (workers);
+  return status;
+}
+
+/**
+## main()
+
+Usage:
+`./getFacetSeries [options] [snapshot ...]`
+
+#### Arguments
+
+- `snapshot`: Snapshots to process, in this order (plain, `.gz` or `.zst`).
+  Without snapshots or `--list`, the snapshot index is read.
+
+#### Options
+
+- `--index=PATH`: snapshot index (default `intermediate/snapshots.index`,
+  paths relative to the current directory, i.e. run from the case
+  directory).
+- `--list=PATH`: file with one snapshot path per line.
+- `--jobs=N`: number of worker processes (default `1`).
+- `--out=PATH`: CSV output file; `-` (default) means `stdout`.
+- `--facets=PATH`: also write the facet sections to `PATH`.
+
+#### Returns
+
+`0` after writing every row, `1` on invalid arguments, on I/O errors or if
+a snapshot could not be restored.
+*/
+int main (int a, char const * arguments[])
+{
+  const char * index = NULL, * list = NULL, * out = "-", * facets_out = NULL;
+  int jobs = 1;
+  for (int k = 1; k < a; k++) {
+    if (!strncmp (arguments[k], "--index=", 8))
+      index = arguments[k] + 8;
+    else if (!strncmp (arguments[k], "--list=", 7))
+      list = arguments[k] + 7;
+    else if (!strncmp (arguments[k], "--jobs=", 7))
+      jobs = atoi (arguments[k] + 7);
+    else if (!strncmp (arguments[k], "--out=", 6))
+      out = arguments[k] + 6;
+    else if (!strncmp (arguments[k], "--facets=", 9))
+      facets_out = arguments[k] + 9;
+    else if (!strncmp (arguments[k], "--", 2)) {
+      fprintf (ferr,
+               "Usage: %s [--index=PATH] [--list=PATH] [--jobs=N]"
+               " [--out=PATH] [--facets=PATH] [snapshot ...]\n",
+               arguments[0]);
+      return 1;
+    }
+    else
+      entry_add (arguments[k], -1.);
+  }
+  if (jobs < 1) {
+    fprintf (ferr, "ERROR: --jobs must be at least 1\n");
+    return 1;
+  }
+
+  if (list && read_list (list))
+    return 1;
+  if ((index || (!list && !nentries)) &&
+      read_index (index ? index : "intermediate/snapshots.index"))
+    return 1;
+  if (!nentries) {
+    fprintf (ferr, "ERROR: no snapshots to process\n");
+    return 1;
+  }
+  if (jobs > nentries)
+    jobs = nentries;
+
+  FILE * csv = strcmp (out, "-") ? fopen (out, "w") : stdout;
+  FILE * facets = facets_out ? fopen (facets_out, "wb") : NULL;
+  if (!csv || (facets_out && !facets)) {
+    fprintf (ferr, "ERROR: cannot open output file %s\n",
+             !csv ? out : facets_out);
+    return 1;
+  }
+
+  fprintf (csv, "file,t,hmin,x_hmin,length,segments\n");
+  int status = jobs == 1 ? run_worker (0, 1, NULL, csv, facets) :
+    run_jobs (jobs, csv, facets);
+
+  if (facets)
+    fclose (facets);
+  if (csv != stdout)
+    fclose (csv);
+  else
+    fflush (csv);
+  free (entries);
+  return status;
+}
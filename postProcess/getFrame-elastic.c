@@ -0,0 +1,249 @@
+/**
+# getFrame-elastic.c
+
+Extract everything one video frame needs from a Basilisk snapshot with a
+single `restore()`.
+
+## Purpose
+
+Combines `getData-elastic.c` and `getFacet.c`: the snapshot is restored
+once, the requested derived fields are evaluated and sampled on a uniform
+window, and the `f` interface segments are collected from the same grid.
+
+## Output
+
+Binary, to `stdout` by default (see `src-local/field-grid-io.h`):
+
+1. the field grid container (`EPOGRID1` header and one column per field),
+2. the facet section (`EPOFACE1`, snapshot time and segments).
+
+## Server Mode
+
+With `--serve`, the helper stays alive and reads one request per line on
+`stdin`, using the same arguments as the command line
+(`snapshot xmin ymin xmax ymax ny [options]`, whitespace-separated, so
+snapshot paths must not contain spaces). Each reply on `stdout` is an
+`int64` byte count followed by the frame products above; a count of `0`
+reports a failed request (the reason goes to `stderr`) and the server
+keeps serving. The process, its field list and the sampling buffer are
+reused across requests, so a video pays for process start-up once per
+worker instead of once per frame. The server exits at end of input.
+
+## Build Example
+
+```bash
+qcc -Wall -O2 -disable-dimensions -Isrc-local postProcess/getFrame-elastic.c -o getFrame -lm
+```
+*/
+
+#include "utils.h"
+#include "output.h"
+#include "fractions.h"
+#include "field-grid-io.h"
+#include "snapshot-io.h"
+
+scalar f[];
+vector u[];
+
+scalar A11[], A12[], A22[]; // conformation tensor
+scalar AThTh[];
+
+scalar D2c[], vel[], trA[];
+
+#include "elastic-sampling.h"
+
+/**
+## Frame Requests
+
+A request holds everything one extraction needs. It is filled from the
+command line or from one line of server input. */
+
+typedef struct {
+  char filename[256];
+  double xmin, ymin, xmax, ymax;
+  int ny, nselected, value_bytes;
+  int selected[ELASTIC_NFIELDS];
+  const char * out;
+} FrameRequest;
+
+/**
+### parse_request()
+
+#### Returns
+- `0` on success, `1` on invalid arguments (reported on `ferr`).
+*/
+static int parse_request (int a, char const * arguments[], FrameRequest * r)
+{
+  if (a < 6) {
+    fprintf (ferr, "ERROR: expected snapshot xmin ymin xmax ymax ny\n");
+    return 1;
+  }
+
+  snprintf (r->filename, sizeof(r->filename), "%s", arguments[0]);
+  r->xmin = atof(arguments[1]); r->ymin = atof(arguments[2]);
+  r->xmax = atof(arguments[3]); r->ymax = atof(arguments[4]);
+  r->ny = atoi(arguments[5]);
+
+  r->nselected = ELASTIC_NFIELDS;
+  for (int k = 0; k < ELASTIC_NFIELDS; k++)
+    r->selected[k] = k;
+  r->value_bytes = 4;
+  r->out = "-";
+  for (int k = 6; k < a; k++) {
+    if (!strncmp (arguments[k], "--fields=", 9)) {
+      r->nselected = elastic_parse_fields (arguments[k] + 9, r->selected);
+      if (r->nselected <= 0) {
+        fprintf (ferr, "ERROR: invalid field list '%s'\n", arguments[k] + 9);
+        return 1;
+      }
+    }
+    else if (!strcmp (arguments[k], "--format=float32"))
+      r->value_bytes = 4;
+    else if (!strcmp (arguments[k], "--format=float64"))
+      r->value_bytes = 8;
+    else if (!strncmp (arguments[k], "--out=", 6))
+      r->out = arguments[k] + 6;
+    else {
+      fprintf (ferr, "ERROR: unknown option '%s'\n", arguments[k]);
+      return 1;
+    }
+  }
+
+  if (r->ny <= 0 || r->xmax <= r->xmin || r->ymax <= r->ymin) {
+    fprintf (ferr, "ERROR: invalid sampling window or ny\n");
+    return 1;
+  }
+  return 0;
+}
+
+/**
+### extract_frame()
+
+Restores the snapshot of `r` and writes its frame products to `fp`. With
+`framed`, the products are preceded by their `int64` byte count, or the
+count `0` alone when the request fails.
+
+#### Returns
+- `0` on success, `1` on restore or I/O errors.
+*/
+static int extract_frame (const FrameRequest * r, FILE * fp, bool framed)
+{
+  if (!snapshot_restore (r->filename, NULL)) {
+    fprintf (ferr, "ERROR: cannot restore %s\n", r->filename);
+    if (framed) {
+      int64_t none = 0;
+      fwrite (&none, sizeof(int64_t), 1, fp);
+      fflush (fp);
+    }
+    return 1;
+  }
+
+  bool want[ELASTIC_NFIELDS] = {false};
+  scalar fields[ELASTIC_NFIELDS] = {D2c, vel, trA};
+  scalar * list = NULL;
+  for (int k = 0; k < r->nselected; k++) {
+    want[r->selected[k]] = true;
+    list = list_add (list, fields[r->selected[k]]);
+  }
+  elastic_derived_fields (D2c, vel, trA, want);
+
+  const char * names[ELASTIC_NFIELDS];
+  for (int k = 0; k < r->nselected; k++)
+    names[k] = elastic_field_names[r->selected[k]];
+  int status = elastic_write_frame (fp, list, names, f, r->xmin, r->ymin,
+                                    r->xmax, r->ymax, r->ny, r->value_bytes,
+                                    framed);
+  free (list);
+  return status;
+}
+
+/**
+### serve()
+
+Answers requests read from `stdin` until end of input. A bad request is
+answered with a zero count and does not stop the server; a failed write
+to `stdout` does.
+
+#### Returns
+- `0` at end of input, `1` if `stdout` is closed.
+*/
+static int serve (void)
+{
+  char line[1024];
+  while (fgets (line, sizeof(line), stdin)) {
+    char const * arguments[32];
+    int a = 0;
+    for (char * tok = strtok (line, " \t\r\n"); tok && a < 32;
+         tok = strtok (NULL, " \t\r\n"))
+      arguments[a++] = tok;
+    if (a == 0)
+      continue;
+
+    FrameRequest r;
+    if (parse_request (a, arguments, &r) || strcmp (r.out, "-")) {
+      if (strcmp (r.out, "-"))
+        fprintf (ferr, "ERROR: --out is not supported in server mode\n");
+      int64_t none = 0;
+      if (fwrite (&none, sizeof(int64_t), 1, stdout) != 1)
+        return 1;
+      fflush (stdout);
+      continue;
+    }
+    if (extract_frame (&r, stdout, true) && ferror (stdout))
+      return 1;
+  }
+  return 0;
+}
+
+/**
+## main()
+
+Usage:
+`./getFrame-elastic snapshot xmin ymin xmax ymax ny [options]`
+or `./getFrame-elastic --serve`
+
+#### Arguments
+
+- `snapshot`: Basilisk dump/snapshot file to restore (plain, `.gz` or `.zst`).
+- `xmin ymin xmax ymax`: sampling rectangle bounds in simulation coordinates.
+- `ny`: number of points along the `y` direction.
+
+#### Options
+
+- `--fields=LIST`: comma-separated subset of `D2c,vel,trA` (default: all).
+- `--format=FMT`: `float32` (default) or `float64` columns.
+- `--out=PATH`: output file; `-` (default) means `stdout`.
+- `--serve`: answer a stream of requests on `stdin` (see Server Mode).
+
+#### Returns
+
+`0` after writing the frame products, `1` on invalid arguments or I/O errors.
+*/
+int main(int a, char const *arguments[])
+{
+  if (a == 2 && !strcmp (arguments[1], "--serve"))
+    return serve();
+
+  if (a < 7) {
+    fprintf(ferr,
+            "Usage: %s snapshot xmin ymin xmax ymax ny"
+            " [--fields=D2c,vel,trA] [--format=float32|float64] [--out=PATH]\n"
+            "       %s --serve\n",
+            arguments[0], arguments[0]);
+    return 1;
+  }
+
+  FrameRequest r;
+  if (parse_request (a - 1, arguments + 1, &r))
+    return 1;
+
+  FILE * fp = strcmp (r.out, "-") ? fopen (r.out, "wb") : stdout;
+  if (!fp) {
+    fprintf (ferr, "ERROR: cannot open output file %s\n", r.out);
+    return 1;
+  }
+  int status = extract_frame (&r, fp, false);
+  if (fp != stdout)
+    fclose (fp);
+  return status;
+}
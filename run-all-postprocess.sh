@@ -1,10 +1,13 @@
 #!/usr/bin/env bash
 # run-all-postprocess.sh
 # Batch post-processing: generates videos for all case directories in simulationCases/
-# Usage: bash run-all-postprocess.sh [--cpus N] [--dry-run]
+# Usage: bash run-all-postprocess.sh [--cpus N] [--sequential] [--dry-run]
 #
-# Processes ONE case at a time (sequential), but each case uses --cpus workers
-# for parallel frame rendering. This avoids overloading the machine.
+# By default every case that still needs a video goes to ONE Video-generic.py
+# run: the get* helpers are compiled once, and frames from all cases share a
+# single pool of --cpus workers, so one case's window detection and ffmpeg
+# encode overlap with the rendering of the others. --sequential restores the
+# former one-case-at-a-time processing, with --cpus workers per case.
 
 set -euo pipefail
 
@@ -16,11 +19,13 @@ LOG_DIR="$REPO_ROOT/postprocess-logs"
 # Defaults
 CPUS=4
 DRY_RUN=false
+SEQUENTIAL=false
 
 # Parse args
 while [[ $# -gt 0 ]]; do
   case "$1" in
     --cpus) CPUS="$2"; shift 2 ;;
+    --sequential) SEQUENTIAL=true; shift ;;
     --dry-run) DRY_RUN=true; shift ;;
     *) echo "Unknown arg: $1"; exit 1 ;;
   esac
@@ -37,7 +42,11 @@ mkdir -p "$LOG_DIR"
 echo "=================================================="
 echo "Batch Post-Processing"
 echo "Repo:    $REPO_ROOT"
-echo "CPUs:    $CPUS per case (sequential case processing)"
+if $SEQUENTIAL; then
+  echo "CPUs:    $CPUS per case (sequential case processing)"
+else
+  echo "CPUs:    $CPUS shared by all cases (one work queue)"
+fi
 echo "Started: $(date)"
 echo "=================================================="
 
@@ -45,6 +54,7 @@ TOTAL=0
 DONE=0
 FAILED=0
 SKIPPED=0
+PENDING=()
 
 # Count eligible cases
 for case_dir in "$SIM_DIR"/c*-{in,out}; do
@@ -74,24 +84,67 @@ for case_dir in "$SIM_DIR"/c*-{in,out}; do
     continue
   fi
   
-  echo "[$case_name] Processing $snap_count snapshots..."
-  log_file="$LOG_DIR/${case_name}.log"
-  
+  echo "[$case_name] Queued $snap_count snapshots"
+  PENDING+=("$case_dir")
+done
+
+if [[ ${#PENDING[@]} -eq 0 ]]; then
+  :
+elif $SEQUENTIAL; then
+  for case_dir in "${PENDING[@]}"; do
+    case_name=$(basename "$case_dir")
+    log_file="$LOG_DIR/${case_name}.log"
+
+    if $DRY_RUN; then
+      echo "  DRY RUN: python3 $PP_SCRIPT --case-dir $case_dir --cpus $CPUS"
+      continue
+    fi
+
+    echo "[$case_name] Processing..."
+    if python3 "$PP_SCRIPT" --case-dir "$case_dir" --cpus "$CPUS" > "$log_file" 2>&1; then
+      DONE=$((DONE + 1))
+      echo "[$case_name] DONE ✓ (log: $log_file)"
+    else
+      FAILED=$((FAILED + 1))
+      echo "[$case_name] FAILED ✗ (log: $log_file)"
+      # Show last 5 lines of error
+      tail -5 "$log_file" | sed "s/^/  /"
+    fi
+  done
+else
+  case_args=()
+  for case_dir in "${PENDING[@]}"; do
+    case_args+=(--case-dir "$case_dir")
+  done
+  log_file="$LOG_DIR/all-cases.log"
+
   if $DRY_RUN; then
-    echo "  DRY RUN: python3 $PP_SCRIPT --case-dir $case_dir --cpus $CPUS"
-    continue
-  fi
-  
-  if python3 "$PP_SCRIPT" --case-dir "$case_dir" --cpus "$CPUS" > "$log_file" 2>&1; then
-    DONE=$((DONE + 1))
-    echo "[$case_name] DONE ✓ (log: $log_file)"
+    echo "  DRY RUN: python3 $PP_SCRIPT --cpus $CPUS ${case_args[*]}"
   else
-    FAILED=$((FAILED + 1))
-    echo "[$case_name] FAILED ✗ (log: $log_file)"
-    # Show last 5 lines of error
-    tail -5 "$log_file" | sed "s/^/  /"
+    echo ""
+    echo "Processing ${#PENDING[@]} cases through one work queue (log: $log_file)..."
+    status=0
+    python3 "$PP_SCRIPT" --cpus "$CPUS" "${case_args[@]}" > "$log_file" 2>&1 || status=$?
+
+    # Video-generic.py reports every case as "[<case>] Wrote video" or
+    # "[<case>] Error: ..." at the end of its log.
+    for case_dir in "${PENDING[@]}"; do
+      case_name=$(basename "$case_dir")
+      if grep -qF "[$case_name] Wrote video" "$log_file"; then
+        DONE=$((DONE + 1))
+        echo "[$case_name] DONE ✓"
+      else
+        FAILED=$((FAILED + 1))
+        echo "[$case_name] FAILED ✗ (log: $log_file)"
+        grep -F "[$case_name] Error" "$log_file" | sed "s/^/  /" || true
+      fi
+    done
+    if [[ $status -ne 0 ]]; then
+      echo "Video-generic.py exited with status $status:"
+      tail -5 "$log_file" | sed "s/^/  /"
+    fi
   fi
-done
+fi
 
 echo ""
 echo "=================================================="
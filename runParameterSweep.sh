@@ -5,6 +5,8 @@
 # The script reads SWEEP_* variables from a sweep config file, generates
 # case-specific parameter files with incrementing CaseNo, then runs each case
 # using runSimulation.sh (sequentially by default, optionally in parallel).
+# Cases start longest-expected first; with --cores, they are packed onto
+# disjoint core sets of the node (see "Scheduling" below).
 
 set -euo pipefail
 
@@ -21,9 +23,24 @@ Options:
   --mode X       Case mode: in or out (default: in)
   --exec FILE    C source in simulationCases/ (overrides --mode mapping)
   --threads N    OpenMP thread count per case (default: 1)
-  --parallel N   Maximum concurrent cases in the sweep (default: 1)
+  --parallel N   Maximum concurrent cases in the sweep (default: 1, or the
+                 core count with --cores)
+  --cores N      Cores available to the sweep (`auto` = all online cores).
+                 Enables core packing: each case is pinned to its own
+                 core set, and cores left over near the end of the queue
+                 go to the remaining cases as extra OpenMP threads
+  --max-threads N
+                 Upper bound for the threads one case can receive with
+                 --cores (default: the core count)
+  --qcc-flags S  Extra compiler flags forwarded to runSimulation.sh
+  --ensemble     Run all cases one after another in a single process
+                 (one build, one launch; for cheap screening runs)
+  --no-build-cache
+                 Compile every case separately instead of sharing the
+                 cached executable of runSimulation.sh
   --CPUs N       Deprecated alias for --threads
-  --mpi          Deprecated; ignored
+  --mpi N        MPI ranks per case, forwarded to runSimulation.sh (default: 1)
+  --mpirun S     MPI launch prefix forwarded to runSimulation.sh
   -n, --dry-run  Show generated parameter combinations only
   -v, --verbose  Print expanded per-case parameter details
   -h, --help     Show this help message
@@ -158,7 +175,14 @@ DRY_RUN=0
 VERBOSE=0
 OMP_THREADS=1
 MAX_PARALLEL=1
-LEGACY_MPI_REQUESTED=0
+MAX_PARALLEL_SET=0
+SWEEP_CORES=""
+MAX_THREADS=""
+EXTRA_QCC_FLAGS=""
+USE_BUILD_CACHE=1
+ENSEMBLE=0
+MPI_RANKS=1
+MPI_LAUNCHER=""
 LEGACY_CPUS_FLAG=0
 
 while [[ $# -gt 0 ]]; do
@@ -217,14 +241,80 @@ while [[ $# -gt 0 ]]; do
         exit 1
       fi
       MAX_PARALLEL="$2"
+      MAX_PARALLEL_SET=1
       shift 2
       ;;
     --parallel=*)
       MAX_PARALLEL="${1#*=}"
+      MAX_PARALLEL_SET=1
+      shift
+      ;;
+    --cores|--max-threads)
+      if [[ -z "${2:-}" ]]; then
+        echo "ERROR: $1 requires a positive integer value." >&2
+        usage
+        exit 1
+      fi
+      if [[ "$1" == "--cores" ]]; then
+        SWEEP_CORES="$2"
+      else
+        MAX_THREADS="$2"
+      fi
+      shift 2
+      ;;
+    --cores=*)
+      SWEEP_CORES="${1#*=}"
+      shift
+      ;;
+    --max-threads=*)
+      MAX_THREADS="${1#*=}"
+      shift
+      ;;
+    --qcc-flags)
+      if [[ $# -lt 2 ]]; then
+        echo "ERROR: --qcc-flags requires a value." >&2
+        usage
+        exit 1
+      fi
+      EXTRA_QCC_FLAGS="$2"
+      shift 2
+      ;;
+    --qcc-flags=*)
+      EXTRA_QCC_FLAGS="${1#*=}"
       shift
       ;;
     --mpi)
-      LEGACY_MPI_REQUESTED=1
+      if [[ -z "${2:-}" ]]; then
+        echo "ERROR: $1 requires a positive integer value." >&2
+        usage
+        exit 1
+      fi
+      MPI_RANKS="$2"
+      shift 2
+      ;;
+    --mpi=*)
+      MPI_RANKS="${1#*=}"
+      shift
+      ;;
+    --mpirun)
+      if [[ -z "${2:-}" ]]; then
+        echo "ERROR: --mpirun requires a launcher command." >&2
+        usage
+        exit 1
+      fi
+      MPI_LAUNCHER="$2"
+      shift 2
+      ;;
+    --mpirun=*)
+      MPI_LAUNCHER="${1#*=}"
+      shift
+      ;;
+    --no-build-cache)
+      USE_BUILD_CACHE=0
+      shift
+      ;;
+    --ensemble)
+      ENSEMBLE=1
       shift
       ;;
     --CPUs|--cpus)
@@ -283,12 +373,46 @@ if [[ ! "$OMP_THREADS" =~ ^[1-9][0-9]*$ ]]; then
   echo "ERROR: --threads must be a positive integer, got: $OMP_THREADS" >&2
   exit 1
 fi
+if [[ ! "$MPI_RANKS" =~ ^[1-9][0-9]*$ ]]; then
+  echo "ERROR: --mpi must be a positive integer, got: $MPI_RANKS" >&2
+  exit 1
+fi
+if [[ "$MPI_RANKS" -gt 1 && "$OMP_THREADS" -gt 1 ]]; then
+  echo "ERROR: --mpi and --threads cannot both exceed 1; Basilisk builds are either OpenMP or MPI." >&2
+  exit 1
+fi
 
 if [[ ! "$MAX_PARALLEL" =~ ^[1-9][0-9]*$ ]]; then
   echo "ERROR: --parallel must be a positive integer, got: $MAX_PARALLEL" >&2
   exit 1
 fi
 
+if [[ "$SWEEP_CORES" == "auto" ]]; then
+  SWEEP_CORES="$(nproc 2>/dev/null || getconf _NPROCESSORS_ONLN)"
+fi
+if [[ -n "$SWEEP_CORES" ]]; then
+  if [[ ! "$SWEEP_CORES" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --cores must be a positive integer or 'auto', got: $SWEEP_CORES" >&2
+    exit 1
+  fi
+  MAX_THREADS="${MAX_THREADS:-$SWEEP_CORES}"
+  if [[ ! "$MAX_THREADS" =~ ^[1-9][0-9]*$ ]]; then
+    echo "ERROR: --max-threads must be a positive integer, got: $MAX_THREADS" >&2
+    exit 1
+  fi
+  CASE_CORES=$((MPI_RANKS > 1 ? MPI_RANKS : OMP_THREADS))
+  if [[ "$CASE_CORES" -gt "$SWEEP_CORES" ]]; then
+    echo "ERROR: one case needs ${CASE_CORES} cores, but --cores is ${SWEEP_CORES}." >&2
+    exit 1
+  fi
+  if [[ $MAX_PARALLEL_SET -eq 0 ]]; then
+    MAX_PARALLEL="$SWEEP_CORES"
+  fi
+elif [[ -n "$MAX_THREADS" ]]; then
+  echo "ERROR: --max-threads requires --cores." >&2
+  exit 1
+fi
+
 MODE="$(printf '%s' "$MODE" | tr '[:upper:]' '[:lower:]')"
 if [[ "$MODE" != "in" && "$MODE" != "out" ]]; then
   echo "ERROR: --mode must be either 'in' or 'out', got: $MODE" >&2
@@ -412,6 +536,39 @@ else
   CASE_END=$((CASE_START + COMBINATION_COUNT - 1))
 fi
 
+# Warm start: with PRECURSOR_CONFIG and WARM_START_TIME in the sweep file,
+# every case branches from one shared precursor run instead of starting
+# from t = 0. The precursor (its own parameter file and CaseNo, typically
+# at a lower MAXlevel) runs first, up to WARM_START_TIME, in
+# simulationCases/c<CaseNo>-<mode>/; each case then restores its latest
+# snapshot at or before that time (warmStart/warmStartTime keys). A
+# precursor that already reached WARM_START_TIME is not run again.
+PRECURSOR_DIR=""
+if [[ -n "${PRECURSOR_CONFIG:-}" ]]; then
+  if [[ -z "${WARM_START_TIME:-}" ]]; then
+    echo "ERROR: PRECURSOR_CONFIG requires WARM_START_TIME in the sweep file." >&2
+    exit 1
+  fi
+  if [[ "$PRECURSOR_CONFIG" != /* ]]; then
+    PRECURSOR_CONFIG="${CONFIG_DIR}/${PRECURSOR_CONFIG}"
+  fi
+  if [[ ! -f "$PRECURSOR_CONFIG" ]]; then
+    echo "ERROR: PRECURSOR_CONFIG file not found: $PRECURSOR_CONFIG" >&2
+    exit 1
+  fi
+  PRECURSOR_CASE_NO="$(get_param_value "CaseNo" "$PRECURSOR_CONFIG")"
+  if [[ ! "$PRECURSOR_CASE_NO" =~ ^[0-9]+$ ]] || [[ "$PRECURSOR_CASE_NO" -lt 1000 ]] ||
+     [[ "$PRECURSOR_CASE_NO" -ge "$CASE_START" && "$PRECURSOR_CASE_NO" -le "$CASE_END" ]]; then
+    echo "ERROR: the precursor needs its own CaseNo >= 1000 outside ${CASE_START}..${CASE_END}, got: ${PRECURSOR_CASE_NO}" >&2
+    exit 1
+  fi
+  PRECURSOR_DIR="${SCRIPT_DIR}/simulationCases/c${PRECURSOR_CASE_NO}-${MODE}"
+  for param_file in "${PARAM_FILES[@]}"; do
+    set_param_in_file "warmStart" "$PRECURSOR_DIR" "$param_file"
+    set_param_in_file "warmStartTime" "$WARM_START_TIME" "$param_file"
+  done
+fi
+
 echo "========================================="
 echo "ElasticPinchOff - Parameter Sweep"
 echo "========================================="
@@ -421,64 +578,306 @@ echo "Mode: ${MODE}"
 echo "Base config: ${BASE_CONFIG}"
 echo "Sweep variables: ${#SWEEP_VARS[@]}"
 echo "Cases: ${CASE_START}..${CASE_END} (${COMBINATION_COUNT})"
-if [[ $OMP_THREADS -gt 1 ]]; then
+if [[ $MPI_RANKS -gt 1 ]]; then
+  echo "Run mode: MPI (ranks per case=${MPI_RANKS})"
+elif [[ $OMP_THREADS -gt 1 ]]; then
   echo "Run mode: OpenMP (threads per case=${OMP_THREADS})"
 else
   echo "Run mode: Serial"
 fi
-if [[ $MAX_PARALLEL -gt 1 ]]; then
+if [[ -n "$SWEEP_CORES" ]]; then
+  echo "Sweep execution: Core packing (cores=${SWEEP_CORES}, max concurrent cases=${MAX_PARALLEL}, max threads per case=${MAX_THREADS})"
+elif [[ $MAX_PARALLEL -gt 1 ]]; then
   echo "Sweep execution: Parallel (max concurrent cases=${MAX_PARALLEL})"
 else
   echo "Sweep execution: Sequential"
 fi
+if [[ -n "$PRECURSOR_DIR" ]]; then
+  echo "Warm start: case ${PRECURSOR_CASE_NO} at t=${WARM_START_TIME}"
+fi
 if [[ $DRY_RUN -eq 1 ]]; then
   echo "Mode: Dry run"
 fi
 echo "========================================="
 echo ""
 
+# Scheduling
+#
+# Every case gets a cost estimate, and cases start in decreasing order of
+# cost (longest processing time first), so the expensive cases do not
+# finish last on an otherwise idle node.
+#
+# - The cost of a finished case (wall seconds x cores) is appended to
+#   COST_CACHE, keyed on the source file and the case parameters without
+#   CaseNo. A case seen before reuses its last recorded cost.
+# - Other cases use the prior tmax/dtmax * 2^MAXlevel, rescaled by the
+#   median recorded/prior ratio of the cases with a history.
+#
+# With --cores, each case is pinned with taskset to its own set of cores.
+# Near the end of the queue, when fewer cases remain than cores are free,
+# the next case receives the free cores divided by the cases that can
+# still start, as extra OpenMP threads (up to --max-threads). A running
+# OpenMP case keeps its thread count, so cores freed by a finished case go
+# to the cases still queued.
+COST_CACHE="${SCRIPT_DIR}/simulationCases/.sweep-costs.tsv"
+
+case_cost_key() {
+  local file="$1"
+  local digest
+  digest="$(grep -v -E '^[[:space:]]*CaseNo[[:space:]]*=' "$file" | sort | cksum | awk '{ print $1 }')"
+  printf '%s:%s' "$EXEC_CODE" "$digest"
+}
+
+estimate_case_costs() {
+  local i file max_level tmax dtmax history scale
+
+  CASE_KEYS=()
+  CASE_COSTS=()
+  local priors=()
+  local histories=()
+  for i in "${!PARAM_FILES[@]}"; do
+    file="${PARAM_FILES[$i]}"
+    CASE_KEYS+=("$(case_cost_key "$file")")
+    max_level="$(get_param_value "MAXlevel" "$file")"
+    tmax="$(get_param_value "tmax" "$file")"
+    dtmax="$(get_param_value "dtmax" "$file")"
+    priors+=("$(awk -v l="${max_level:-12}" -v t="${tmax:-200}" -v d="${dtmax:-1e-5}" \
+      'BEGIN { printf "%.6g", t/d*2^l }')")
+    history=""
+    if [[ -f "$COST_CACHE" ]]; then
+      history="$(awk -F '\t' -v k="${CASE_KEYS[$i]}" '$1 == k { c = $2 } END { if (c != "") print c }' \
+        "$COST_CACHE")"
+    fi
+    histories+=("$history")
+  done
+
+  scale="$(
+    for i in "${!PARAM_FILES[@]}"; do
+      if [[ -n "${histories[$i]}" ]]; then
+        awk -v h="${histories[$i]}" -v p="${priors[$i]}" 'BEGIN { printf "%.6g\n", h/p }'
+      fi
+    done | sort -g | awk '{ r[NR] = $1 } END { print NR ? r[int((NR + 1)/2)] : 1 }'
+  )"
+
+  for i in "${!PARAM_FILES[@]}"; do
+    if [[ -n "${histories[$i]}" ]]; then
+      CASE_COSTS+=("${histories[$i]}")
+    else
+      CASE_COSTS+=("$(awk -v p="${priors[$i]}" -v s="$scale" 'BEGIN { printf "%.6g", p*s }')")
+    fi
+  done
+}
+
+estimate_case_costs
+read -r -a CASE_ORDER <<< "$(
+  for i in "${!PARAM_FILES[@]}"; do
+    printf '%s %s\n' "${CASE_COSTS[$i]}" "$i"
+  done | sort -k1,1gr -k2,2n | awk '{ printf "%s ", $2 }'
+)"
+
+if [[ $DRY_RUN -eq 1 || $VERBOSE -eq 1 ]]; then
+  echo "Launch order (estimated cost; core-seconds when recorded):"
+  for i in "${CASE_ORDER[@]}"; do
+    echo "  Case $(get_param_value "CaseNo" "${PARAM_FILES[$i]}"): ${CASE_COSTS[$i]}"
+  done
+  echo ""
+fi
+
 if [[ $DRY_RUN -eq 1 ]]; then
   echo "Dry run complete. No simulations executed."
   exit 0
 fi
 
+if [[ -n "$PRECURSOR_DIR" ]]; then
+  precursor_marker="${PRECURSOR_DIR}/.precursor-tmax"
+  if [[ -f "$precursor_marker" ]] &&
+     awk -v a="$(cat "$precursor_marker")" -v b="$WARM_START_TIME" 'BEGIN { exit !(a >= b) }'; then
+    echo "Precursor case ${PRECURSOR_CASE_NO} already reached t=${WARM_START_TIME}"
+  else
+    precursor_file="${TEMP_DIR}/precursor.params"
+    cp "$PRECURSOR_CONFIG" "$precursor_file"
+    set_param_in_file "tmax" "$WARM_START_TIME" "$precursor_file"
+    run_cmd=(bash "$RUN_SIM_SCRIPT" "$precursor_file" --mode "$MODE" --exec "$EXEC_CODE" --threads "$OMP_THREADS")
+    if [[ $MPI_RANKS -gt 1 ]]; then
+      run_cmd+=(--mpi "$MPI_RANKS")
+      if [[ -n "$MPI_LAUNCHER" ]]; then
+        run_cmd+=(--mpirun "$MPI_LAUNCHER")
+      fi
+    fi
+    if [[ -n "$EXTRA_QCC_FLAGS" ]]; then
+      run_cmd+=(--qcc-flags "$EXTRA_QCC_FLAGS")
+    fi
+    if [[ $USE_BUILD_CACHE -eq 0 ]]; then
+      run_cmd+=(--no-build-cache)
+    fi
+    echo "Running precursor case ${PRECURSOR_CASE_NO} up to t=${WARM_START_TIME}"
+    if ! "${run_cmd[@]}"; then
+      echo "ERROR: precursor case ${PRECURSOR_CASE_NO} failed." >&2
+      exit 1
+    fi
+    printf '%s\n' "$WARM_START_TIME" > "$precursor_marker"
+  fi
+  echo ""
+fi
+
+# Ensemble: concatenate the case files as `[case]` blocks and hand them to
+# a single runSimulation.sh process. The cases run in
+# simulationCases/c<CASE_START>-<mode>/c<CaseNo>/, and their results are
+# listed in ensemble-summary there.
+if [[ $ENSEMBLE -eq 1 ]]; then
+  ensemble_file="${TEMP_DIR}/ensemble.params"
+  : > "$ensemble_file"
+  for param_file in "${PARAM_FILES[@]}"; do
+    printf '[case]\n' >> "$ensemble_file"
+    cat "$param_file" >> "$ensemble_file"
+  done
+
+  run_cmd=(bash "$RUN_SIM_SCRIPT" "$ensemble_file" --mode "$MODE" --exec "$EXEC_CODE" --threads "$OMP_THREADS")
+  if [[ $MPI_RANKS -gt 1 ]]; then
+    run_cmd+=(--mpi "$MPI_RANKS")
+    if [[ -n "$MPI_LAUNCHER" ]]; then
+      run_cmd+=(--mpirun "$MPI_LAUNCHER")
+    fi
+  fi
+  if [[ -n "$EXTRA_QCC_FLAGS" ]]; then
+    run_cmd+=(--qcc-flags "$EXTRA_QCC_FLAGS")
+  fi
+  if [[ $USE_BUILD_CACHE -eq 0 ]]; then
+    run_cmd+=(--no-build-cache)
+  fi
+  echo "Running ${COMBINATION_COUNT} cases as one ensemble process"
+  if "${run_cmd[@]}"; then
+    status=0
+  else
+    status=$?
+  fi
+  echo "Ensemble summary: simulationCases/c${CASE_START}-${MODE}/ensemble-summary"
+  exit "$status"
+fi
+
 SUCCESSFUL=0
 FAILED=0
 RUN_PIDS=()
 RUN_CASE_NOS=()
+RUN_CASE_IDX=()
+RUN_STARTS=()
+RUN_CORE_COUNTS=()
+RUN_CORE_LISTS=()
 
-if [[ $LEGACY_MPI_REQUESTED -eq 1 ]]; then
-  echo "WARNING: --mpi is deprecated and ignored." >&2
-fi
 if [[ $LEGACY_CPUS_FLAG -eq 1 ]]; then
   echo "WARNING: --CPUs/--cpus is deprecated; use --threads." >&2
 fi
 
-wait_for_pid_index() {
+# Core IDs come from the affinity of this shell (e.g. the cores a batch
+# scheduler granted), so pinned sets stay inside the allocation.
+USE_TASKSET=0
+CORE_IDS=()
+CORE_OWNER=()
+FREE_CORES=0
+if [[ -n "$SWEEP_CORES" ]]; then
+  FREE_CORES="$SWEEP_CORES"
+  if [[ $MPI_RANKS -eq 1 ]] && command -v taskset >/dev/null 2>&1; then
+    USE_TASKSET=1
+    read -r -a CORE_IDS <<< "$(
+      taskset -pc $$ | awk -F ': *' '{ print $2 }' | tr ',' '\n' |
+        awk -F '-' '{ for (c = $1; c <= (NF > 1 ? $2 : $1); c++) printf "%d ", c }'
+    )"
+    if [[ ${#CORE_IDS[@]} -lt $SWEEP_CORES ]]; then
+      echo "ERROR: --cores ${SWEEP_CORES} exceeds the ${#CORE_IDS[@]} core(s) this shell may run on." >&2
+      exit 1
+    fi
+  elif [[ $MPI_RANKS -eq 1 ]]; then
+    echo "WARNING: taskset not found; cases are not pinned to cores." >&2
+  fi
+  for ((c = 0; c < SWEEP_CORES; c++)); do
+    CORE_OWNER[c]=0
+    if [[ $USE_TASKSET -eq 0 ]]; then
+      CORE_IDS[c]="$c"
+    fi
+  done
+fi
+
+# allocate_cores N: claims the N lowest free cores and stores them as a
+# taskset list in ALLOCATED_CORES.
+allocate_cores() {
+  local n="$1"
+  local c
+  ALLOCATED_CORES=""
+  for ((c = 0; c < SWEEP_CORES && n > 0; c++)); do
+    if [[ "${CORE_OWNER[c]}" -eq 0 ]]; then
+      CORE_OWNER[c]=1
+      ALLOCATED_CORES+="${ALLOCATED_CORES:+,}${CORE_IDS[c]}"
+      n=$((n - 1))
+    fi
+  done
+  FREE_CORES=$((FREE_CORES - $1))
+}
+
+release_cores() {
+  local list=",$1,"
+  local c
+  for ((c = 0; c < SWEEP_CORES; c++)); do
+    if [[ "$list" == *",${CORE_IDS[c]},"* ]]; then
+      CORE_OWNER[c]=0
+    fi
+  done
+}
+
+finish_case() {
   local idx="$1"
-  local pid="${RUN_PIDS[$idx]}"
+  local status="$2"
   local case_no="${RUN_CASE_NOS[$idx]}"
+  local case_idx="${RUN_CASE_IDX[$idx]}"
+  local elapsed=$(( $(date +%s) - RUN_STARTS[idx] ))
 
-  if wait "$pid"; then
+  if [[ "$status" -eq 0 ]]; then
     ((SUCCESSFUL += 1))
-    echo "Case ${case_no} completed."
+    echo "Case ${case_no} completed in ${elapsed}s on ${RUN_CORE_COUNTS[$idx]} core(s)."
+    mkdir -p "$(dirname "$COST_CACHE")"
+    printf '%s\t%s\t%s\t%s\n' "${CASE_KEYS[$case_idx]}" \
+      "$((elapsed * RUN_CORE_COUNTS[idx]))" "${RUN_CORE_COUNTS[$idx]}" "$case_no" \
+      >> "$COST_CACHE"
   else
     ((FAILED += 1))
     echo "ERROR: Case ${case_no} failed." >&2
   fi
 
-  unset 'RUN_PIDS[idx]'
-  unset 'RUN_CASE_NOS[idx]'
+  if [[ -n "$SWEEP_CORES" ]]; then
+    release_cores "${RUN_CORE_LISTS[$idx]}"
+    FREE_CORES=$((FREE_CORES + RUN_CORE_COUNTS[idx]))
+  fi
+
+  unset 'RUN_PIDS[idx]' 'RUN_CASE_NOS[idx]' 'RUN_CASE_IDX[idx]' 'RUN_STARTS[idx]'
+  unset 'RUN_CORE_COUNTS[idx]' 'RUN_CORE_LISTS[idx]'
   RUN_PIDS=("${RUN_PIDS[@]}")
   RUN_CASE_NOS=("${RUN_CASE_NOS[@]}")
+  RUN_CASE_IDX=("${RUN_CASE_IDX[@]}")
+  RUN_STARTS=("${RUN_STARTS[@]}")
+  RUN_CORE_COUNTS=("${RUN_CORE_COUNTS[@]}")
+  RUN_CORE_LISTS=("${RUN_CORE_LISTS[@]}")
 }
 
+# Blocks until one running case exits. Bash >= 5.1 sleeps in `wait -n -p`;
+# older shells poll once per second.
 wait_for_one_active_case() {
-  local idx
+  local idx finished status
+  if (( BASH_VERSINFO[0] > 5 || (BASH_VERSINFO[0] == 5 && BASH_VERSINFO[1] >= 1) )); then
+    status=0
+    wait -n -p finished "${RUN_PIDS[@]}" || status=$?
+    for idx in "${!RUN_PIDS[@]}"; do
+      if [[ "${RUN_PIDS[$idx]}" == "$finished" ]]; then
+        finish_case "$idx" "$status"
+        return
+      fi
+    done
+    return
+  fi
   while true; do
     for idx in "${!RUN_PIDS[@]}"; do
       if ! kill -0 "${RUN_PIDS[$idx]}" 2>/dev/null; then
-        wait_for_pid_index "$idx"
+        status=0
+        wait "${RUN_PIDS[$idx]}" || status=$?
+        finish_case "$idx" "$status"
         return
       fi
     done
@@ -486,26 +885,73 @@ wait_for_one_active_case() {
   done
 }
 
-for param_file in "${PARAM_FILES[@]}"; do
+for ((position = 0; position < ${#CASE_ORDER[@]}; position++)); do
+  case_idx="${CASE_ORDER[$position]}"
+  param_file="${PARAM_FILES[$case_idx]}"
   case_no="$(get_param_value "CaseNo" "$param_file")"
   ec_value="$(get_param_value "Ec" "$param_file")"
   de_value="$(get_param_value "De" "$param_file")"
   tmax_value="$(get_param_value "tmax" "$param_file")"
 
+  case_threads="$OMP_THREADS"
+  case_cores="$MPI_RANKS"
+  core_list=""
+  if [[ -n "$SWEEP_CORES" ]]; then
+    case_cores="$CASE_CORES"
+    while [[ ${#RUN_PIDS[@]} -ge $MAX_PARALLEL || $FREE_CORES -lt $case_cores ]]; do
+      wait_for_one_active_case
+    done
+    if [[ $MPI_RANKS -eq 1 ]]; then
+      queued=$(( ${#CASE_ORDER[@]} - position ))
+      slots=$(( MAX_PARALLEL - ${#RUN_PIDS[@]} ))
+      slots=$(( queued < slots ? queued : slots ))
+      share=$(( FREE_CORES / slots ))
+      share=$(( share < MAX_THREADS ? share : MAX_THREADS ))
+      case_threads=$(( share > OMP_THREADS ? share : OMP_THREADS ))
+      case_cores="$case_threads"
+    fi
+    allocate_cores "$case_cores"
+    core_list="$ALLOCATED_CORES"
+  else
+    case_cores=$(( MPI_RANKS > OMP_THREADS ? MPI_RANKS : OMP_THREADS ))
+    while [[ ${#RUN_PIDS[@]} -ge $MAX_PARALLEL ]]; do
+      wait_for_one_active_case
+    done
+  fi
+
   echo "-----------------------------------------"
-  echo "Launching Case ${case_no}"
+  echo "Launching Case ${case_no} (estimated cost ${CASE_COSTS[$case_idx]})"
   echo "Ec=${ec_value:-NA}, De=${de_value:-NA}, tmax=${tmax_value:-NA}"
+  if [[ -n "$core_list" ]]; then
+    echo "Cores: ${core_list} (threads=${case_threads})"
+  fi
   echo "Expected log file: c${case_no}-log"
   echo "-----------------------------------------"
 
-  run_cmd=(bash "$RUN_SIM_SCRIPT" "$param_file" --mode "$MODE" --exec "$EXEC_CODE" --threads "$OMP_THREADS")
-  "${run_cmd[@]}" &
+  run_cmd=(bash "$RUN_SIM_SCRIPT" "$param_file" --mode "$MODE" --exec "$EXEC_CODE" --threads "$case_threads")
+  if [[ $MPI_RANKS -gt 1 ]]; then
+    run_cmd+=(--mpi "$MPI_RANKS")
+    if [[ -n "$MPI_LAUNCHER" ]]; then
+      run_cmd+=(--mpirun "$MPI_LAUNCHER")
+    fi
+  fi
+  if [[ -n "$EXTRA_QCC_FLAGS" ]]; then
+    run_cmd+=(--qcc-flags "$EXTRA_QCC_FLAGS")
+  fi
+  if [[ $USE_BUILD_CACHE -eq 0 ]]; then
+    run_cmd+=(--no-build-cache)
+  fi
+  if [[ $USE_TASKSET -eq 1 ]]; then
+    OMP_PROC_BIND=close OMP_PLACES=cores taskset -c "$core_list" "${run_cmd[@]}" &
+  else
+    "${run_cmd[@]}" &
+  fi
   RUN_PIDS+=("$!")
   RUN_CASE_NOS+=("$case_no")
-
-  if [[ ${#RUN_PIDS[@]} -ge $MAX_PARALLEL ]]; then
-    wait_for_one_active_case
-  fi
+  RUN_CASE_IDX+=("$case_idx")
+  RUN_STARTS+=("$(date +%s)")
+  RUN_CORE_COUNTS+=("$case_cores")
+  RUN_CORE_LISTS+=("$core_list")
   echo ""
 done
 
@@ -3,10 +3,17 @@
 #
 # Run a single ElasticPinchOff simulation from the repository root.
 # The script creates simulationCases/c<CaseNo>-<mode>/, copies the parameter
-# file and source file, compiles the selected case, and runs it.
+# file and source file, compiles the selected case, and runs it serially,
+# with OpenMP threads, or on MPI ranks.
 #
 # Usage:
 #   bash runSimulation.sh [params_file] [--mode in|out] [--exec exec_code] [--threads N]
+#                         [--mpi N] [--mpirun "LAUNCHER"] [--qcc-flags "FLAGS"]
+#
+# Executables are cached in .build-cache/<key>/, where the key hashes the
+# case source, every src-local/ header, the compiler and the compile flags.
+# All cases of a sweep read their parameters at runtime, so they share one
+# build.
 
 set -euo pipefail
 
@@ -22,13 +29,30 @@ Arguments:
 Options:
   --mode X       Case mode: in or out (default: in)
   --exec FILE    C source in simulationCases/ (overrides --mode mapping)
-  --threads N    Thread count; N=1 runs serial (default: 1)
+  --threads N    OpenMP thread count; N=1 runs serial (default: 1)
+  --mpi N        MPI rank count; N>1 builds with -D_MPI=1 and runs under MPI
+                 (default: 1)
+  --mpirun S     MPI launch prefix, e.g. "srun -n 64" (default: "mpirun -np N")
+  --qcc-flags S  Extra compiler flags, e.g. "-DFUSED_LOG_CONFORM=1 -march=native"
+  --no-build-cache
+                 Always compile in the case directory (default: reuse a
+                 cached executable; cache root: $BUILD_CACHE_DIR or
+                 .build-cache/)
   --CPUs N       Deprecated alias for --threads
-  --mpi          Deprecated; ignored
   -h, --help     Show this help message
 EOF
 }
 
+hash_stream() {
+  if command -v sha256sum >/dev/null 2>&1; then
+    sha256sum | awk '{ print $1 }'
+  elif command -v shasum >/dev/null 2>&1; then
+    shasum -a 256 | awk '{ print $1 }'
+  else
+    cksum | awk '{ print $1 "-" $2 }'
+  fi
+}
+
 get_param_value() {
   local key="$1"
   local file="$2"
@@ -56,7 +80,10 @@ MODE_SET=0
 PARAM_FILE="default.params"
 PARAM_FILE_SET=0
 OMP_THREADS=1
-LEGACY_MPI_REQUESTED=0
+EXTRA_QCC_FLAGS=""
+USE_BUILD_CACHE=1
+MPI_RANKS=1
+MPI_LAUNCHER=""
 LEGACY_CPUS_FLAG=0
 
 while [[ $# -gt 0 ]]; do
@@ -96,7 +123,29 @@ while [[ $# -gt 0 ]]; do
       shift
       ;;
     --mpi)
-      LEGACY_MPI_REQUESTED=1
+      if [[ -z "${2:-}" ]]; then
+        echo "ERROR: $1 requires a positive integer value." >&2
+        usage
+        exit 1
+      fi
+      MPI_RANKS="$2"
+      shift 2
+      ;;
+    --mpi=*)
+      MPI_RANKS="${1#*=}"
+      shift
+      ;;
+    --mpirun)
+      if [[ -z "${2:-}" ]]; then
+        echo "ERROR: --mpirun requires a launcher command." >&2
+        usage
+        exit 1
+      fi
+      MPI_LAUNCHER="$2"
+      shift 2
+      ;;
+    --mpirun=*)
+      MPI_LAUNCHER="${1#*=}"
       shift
       ;;
     --threads)
@@ -112,6 +161,23 @@ while [[ $# -gt 0 ]]; do
       OMP_THREADS="${1#*=}"
       shift
       ;;
+    --qcc-flags)
+      if [[ $# -lt 2 ]]; then
+        echo "ERROR: --qcc-flags requires a value." >&2
+        usage
+        exit 1
+      fi
+      EXTRA_QCC_FLAGS="$2"
+      shift 2
+      ;;
+    --qcc-flags=*)
+      EXTRA_QCC_FLAGS="${1#*=}"
+      shift
+      ;;
+    --no-build-cache)
+      USE_BUILD_CACHE=0
+      shift
+      ;;
     --CPUs|--cpus)
       if [[ -z "${2:-}" ]]; then
         echo "ERROR: $1 requires a positive integer value." >&2
@@ -161,6 +227,19 @@ if [[ ! "$OMP_THREADS" =~ ^[1-9][0-9]*$ ]]; then
   exit 1
 fi
 
+if [[ ! "$MPI_RANKS" =~ ^[1-9][0-9]*$ ]]; then
+  echo "ERROR: --mpi must be a positive integer, got: $MPI_RANKS" >&2
+  exit 1
+fi
+
+# Basilisk selects either its OpenMP or its MPI parallel backend at compile
+# time (pid(), reductions, boundaries); it has no hybrid build.
+if [[ "$MPI_RANKS" -gt 1 && "$OMP_THREADS" -gt 1 ]]; then
+  echo "ERROR: --mpi and --threads cannot both exceed 1; Basilisk builds are either OpenMP or MPI." >&2
+  echo "Hint: run one MPI rank per core instead, e.g. --mpi $((MPI_RANKS * OMP_THREADS))." >&2
+  exit 1
+fi
+
 MODE="$(printf '%s' "$MODE" | tr '[:upper:]' '[:lower:]')"
 if [[ "$MODE" != "in" && "$MODE" != "out" ]]; then
   echo "ERROR: --mode must be either 'in' or 'out', got: $MODE" >&2
@@ -175,9 +254,6 @@ if [[ $EXEC_CODE_SET -eq 0 ]]; then
   fi
 fi
 
-if [[ $LEGACY_MPI_REQUESTED -eq 1 ]]; then
-  echo "WARNING: --mpi is deprecated and ignored." >&2
-fi
 if [[ $LEGACY_CPUS_FLAG -eq 1 ]]; then
   echo "WARNING: --CPUs/--cpus is deprecated; use --threads." >&2
 fi
@@ -186,6 +262,13 @@ USE_OPENMP=0
 if [[ "$OMP_THREADS" -gt 1 ]]; then
   USE_OPENMP=1
 fi
+USE_MPI=0
+if [[ "$MPI_RANKS" -gt 1 ]]; then
+  USE_MPI=1
+  if [[ -z "$MPI_LAUNCHER" ]]; then
+    MPI_LAUNCHER="mpirun -np ${MPI_RANKS}"
+  fi
+fi
 
 if [[ "$EXEC_CODE" != *.c ]]; then
   EXEC_CODE="${EXEC_CODE}.c"
@@ -217,6 +300,19 @@ if ! command -v qcc >/dev/null 2>&1; then
   exit 1
 fi
 
+MPI_CC="${MPI_CC:-mpicc}"
+if [[ $USE_MPI -eq 1 ]]; then
+  if ! command -v "$MPI_CC" >/dev/null 2>&1; then
+    echo "ERROR: ${MPI_CC} not found in PATH (set MPI_CC to the MPI C compiler)." >&2
+    exit 1
+  fi
+  read -r -a MPI_LAUNCHER_ARRAY <<< "$MPI_LAUNCHER"
+  if ! command -v "${MPI_LAUNCHER_ARRAY[0]}" >/dev/null 2>&1; then
+    echo "ERROR: MPI launcher not found: ${MPI_LAUNCHER_ARRAY[0]}" >&2
+    exit 1
+  fi
+fi
+
 if [[ ! -f "$PARAM_FILE" ]]; then
   echo "ERROR: Parameter file not found: $PARAM_FILE" >&2
   exit 1
@@ -258,11 +354,16 @@ echo "Mode: ${MODE}"
 echo "Parameter file: ${PARAM_FILE}"
 echo "CaseNo: ${CASE_NO}"
 echo "Case directory: ${CASE_DIR}"
-if [[ $USE_OPENMP -eq 1 ]]; then
+if [[ $USE_MPI -eq 1 ]]; then
+  echo "Run mode: MPI (ranks=${MPI_RANKS}, launcher: ${MPI_LAUNCHER})"
+elif [[ $USE_OPENMP -eq 1 ]]; then
   echo "Run mode: OpenMP (threads=${OMP_THREADS})"
 else
   echo "Run mode: Serial"
 fi
+if [[ -n "$EXTRA_QCC_FLAGS" ]]; then
+  echo "Extra qcc flags: ${EXTRA_QCC_FLAGS}"
+fi
 echo "Expected log file: ${CASE_LOG_FILE}"
 echo "========================================="
 echo ""
@@ -273,25 +374,98 @@ cp "$SRC_FILE_ORIG" "$CASE_DIR/$SRC_FILE_LOCAL"
 
 cd "$CASE_DIR"
 
-echo "Compiling ${SRC_FILE_LOCAL} ..."
-QCC_FLAGS=(-I../../src-local -O2 -Wall -disable-dimensions)
+QCC_FLAGS=(-O2 -Wall -disable-dimensions)
 if [[ $USE_OPENMP -eq 1 ]]; then
   QCC_FLAGS+=(-fopenmp)
 fi
-if ! qcc "${QCC_FLAGS[@]}" "$SRC_FILE_LOCAL" -o "$EXECUTABLE_NAME" -lm; then
+if [[ $USE_MPI -eq 1 ]]; then
+  QCC_FLAGS+=(-D_MPI=1)
+fi
+if [[ -n "$EXTRA_QCC_FLAGS" ]]; then
+  read -r -a EXTRA_QCC_FLAG_ARRAY <<< "$EXTRA_QCC_FLAGS"
+  QCC_FLAGS+=("${EXTRA_QCC_FLAG_ARRAY[@]}")
+fi
+if [[ $USE_MPI -eq 1 ]]; then
+  # qcc compiles its generated C with $CC99.
+  export CC99="${MPI_CC} -std=c99"
+fi
+
+compile_failed() {
   if [[ $USE_OPENMP -eq 1 ]]; then
     echo "ERROR: OpenMP build failed. Re-run with --threads 1 for serial mode." >&2
+  elif [[ $USE_MPI -eq 1 ]]; then
+    echo "ERROR: MPI build failed. Re-run with --mpi 1 for serial mode." >&2
   fi
   exit 1
+}
+
+if [[ $USE_BUILD_CACHE -eq 1 ]]; then
+  # Key: case source, src-local/ headers (names and contents), qcc and the
+  # C compiler it calls, and the flags.
+  BUILD_KEY="$(
+    {
+      printf 'source %s\n' "$EXEC_CODE"
+      cat "$SRC_FILE_ORIG"
+      for header in "${SCRIPT_DIR}"/src-local/*.h; do
+        printf 'header %s\n' "${header##*/}"
+        cat "$header"
+      done
+      printf 'qcc %s\n' "$(command -v qcc)"
+      printf 'cc99 %s\n' "${CC99:-}"
+      printf 'flags %s\n' "${QCC_FLAGS[*]}"
+    } | hash_stream
+  )"
+  BUILD_CACHE_ROOT="${BUILD_CACHE_DIR:-${SCRIPT_DIR}/.build-cache}"
+  BUILD_DIR="${BUILD_CACHE_ROOT}/${BUILD_KEY}"
+  CACHED_EXECUTABLE="${BUILD_DIR}/${EXECUTABLE_NAME}"
+  mkdir -p "$BUILD_DIR"
+
+  # Concurrent sweep cases with the same key wait for a single compile.
+  exec 9> "${BUILD_DIR}/.lock"
+  if command -v flock >/dev/null 2>&1; then
+    flock 9
+  fi
+  if [[ -x "$CACHED_EXECUTABLE" ]]; then
+    echo "Reusing cached executable: ${CACHED_EXECUTABLE#"${SCRIPT_DIR}"/}"
+  else
+    echo "Compiling ${SRC_FILE_LOCAL} into the build cache ..."
+    BUILD_TMP="$(mktemp -d "${BUILD_DIR}/build.XXXXXX")"
+    cp "$SRC_FILE_ORIG" "${BUILD_TMP}/${SRC_FILE_LOCAL}"
+    if ! (cd "$BUILD_TMP" &&
+          qcc -I"${SCRIPT_DIR}/src-local" "${QCC_FLAGS[@]}" "$SRC_FILE_LOCAL" \
+            -o "$EXECUTABLE_NAME" -lm); then
+      rm -rf "$BUILD_TMP"
+      compile_failed
+    fi
+    mv "${BUILD_TMP}/${EXECUTABLE_NAME}" "$CACHED_EXECUTABLE"
+    printf '%s\n' "${QCC_FLAGS[*]}" > "${BUILD_DIR}/flags"
+    rm -rf "$BUILD_TMP"
+  fi
+  exec 9>&-
+
+  ln -f "$CACHED_EXECUTABLE" "$EXECUTABLE_NAME" 2>/dev/null ||
+    cp "$CACHED_EXECUTABLE" "$EXECUTABLE_NAME"
+else
+  echo "Compiling ${SRC_FILE_LOCAL} ..."
+  if ! qcc -I../../src-local "${QCC_FLAGS[@]}" "$SRC_FILE_LOCAL" -o "$EXECUTABLE_NAME" -lm; then
+    compile_failed
+  fi
 fi
-echo "Compilation successful: $EXECUTABLE_NAME"
+echo "Executable ready: $EXECUTABLE_NAME"
 echo ""
 
 if [[ -f "restart" ]]; then
   echo "Restart file found - simulation will resume from checkpoint."
 fi
 
-if [[ $USE_OPENMP -eq 1 ]]; then
+if [[ $USE_MPI -eq 1 ]]; then
+  echo "Running: ${MPI_LAUNCHER} ./${EXECUTABLE_NAME} case.params"
+  if OMP_NUM_THREADS=1 "${MPI_LAUNCHER_ARRAY[@]}" ./"$EXECUTABLE_NAME" case.params; then
+    EXIT_CODE=0
+  else
+    EXIT_CODE=$?
+  fi
+elif [[ $USE_OPENMP -eq 1 ]]; then
   echo "Running: OMP_NUM_THREADS=${OMP_THREADS} ./${EXECUTABLE_NAME} case.params"
   if OMP_NUM_THREADS="$OMP_THREADS" ./"$EXECUTABLE_NAME" case.params; then
     EXIT_CODE=0
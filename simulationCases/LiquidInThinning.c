@@ -10,6 +10,9 @@ Fluid assignment:
 
 Runtime parameters are loaded from a `key=value` file through
 `src-local/params.h`.
+A file with `[case]` blocks is an ensemble: its cases run one after
+another in this process, each in its own `c<CaseNo>/` directory, with a
+per-case summary in `ensemble-summary` (see `run_ensemble()`).
 
 ## Input Parameters
 
@@ -18,7 +21,48 @@ This case expects runtime keys such as:
 - `MAXlevel`
 - `Oh`, `Oha`
 - `De`, `Ec`
-- `tmax`, `dtmax`
+- `tmax`, `dtmax` (fixed time step with `dtAdaptive=false`, default `1e-5`)
+- `dtAdaptive` (pick each step from the advection, capillary, viscous and
+  elastic limits of `src-local/dt-control.h`, default `false`), `dtCap`
+  (upper bound of the adaptive step, default `1e-3`),
+  `dtViscous` (coefficient of the viscous limit, `0` disables it, default
+  `0`), `dtGrowth` (largest step ratio between two steps, default `1.1`)
+- `adaptEvery` (steps between mesh adaptations, default `1`),
+  `adaptMove` (interface motion in cells of `maxlevelLocal` that forces an
+  adaptation, `0` disables, default `0.5`), `adaptNeck` (neck radius
+  below which every step adapts, default `0.1`), `adaptIndicator`
+  (`full`, or `trace` to test the conformation trace instead of its
+  components, default `full`; see `src-local/adapt-schedule.h`)
+- `tolerance` (multigrid `TOLERANCE`, default `1e-4`), `tolAdaptive`
+  (tighten the tolerance with the neck radius instead, default `false`),
+  `tolMax`, `tolMin` (loosest and tightest adaptive tolerance, defaults
+  `1e-3`, `1e-6`), `tolNeck` (neck radius below which it tightens, default
+  `0.6`), `tolIterMax` (cycles of one solve that make the policy fall back
+  to `tolerance`, default `50`), `solverExtrapolate` (start the projection
+  from the pressure extrapolated from the last two steps, default
+  `false`), `solverLog` (per-step multigrid statistics in
+  `c<CaseNo>-solver.csv`, default `true`; see `src-local/solver-control.h`)
+- `logFlushEvery` (rows buffered between log writes, default `100`),
+  `logEchoEvery` (echo one row in N to `stderr`, `0` disables, default `1`),
+  `logBinary` (also write `c<CaseNo>-log.bin`, default `false`)
+- `snapshotPrimitive` (snapshots keep only `f`, `u`, `p` and the
+  conformation tensor, default `true`), `snapshotCompress` (`none`,
+  `gzip` or `zstd`, default `none`), `trestart` (restart file interval,
+  default `0.05`), `snapshotAsync` (write snapshots and restarts from a
+  background thread, default `false`; ignored with a warning under MPI),
+  `snapshotQueue` (snapshots held in memory at most while writing in the
+  background, default `2`)
+- `tframe` (in-situ frame interval, `0` disables, default `0`),
+  `frameXmin`, `frameXmax`, `frameYmin`, `frameYmax`, `frameNy` (sampling
+  window and resolution, defaults `0`, `4*pi`, `0`, `2`, `400`)
+- `warmStart` (start from another case's snapshot instead of `t = 0`: a
+  snapshot file, or with `warmStartTime` a case directory; relative to
+  the run directory, default none), `warmStartTime` (pick the latest
+  snapshot at or before this time from the `intermediate/snapshots.index`
+  of the `warmStart` directory, default unset)
+- `profileEvery` (steps between rows of `c<CaseNo>-profile.csv`, default
+  `100`; only read in builds with `-DPROFILE_EVENTS=1`, see
+  `src-local/event-profile.h`)
 */
 
 #define ADAPT_MAXLEVEL 1
@@ -35,6 +79,17 @@ This case expects runtime keys such as:
 #include "tension.h"
 #include "distance.h"
 #include "params.h"
+#include "diagnostics-log.h"
+#include "dt-control.h"
+#include "interface-geometry.h"
+#include "adapt-schedule.h"
+#include "solver-control.h"
+#include "snapshot-io.h"
+#include "elastic-sampling.h"
+#include "event-profile.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
 
 /**
 ## Output and Adaptivity Controls
@@ -59,35 +114,41 @@ p[top] = dirichlet(0.);
 These are populated from the parameter file using default fallbacks.
 */
 int MAXlevel, MINlevel, maxlevelLocal, CaseNo;
+int logFlushEvery, logEchoEvery;
+bool logBinary;
+bool solverLog;
+bool snapshotPrimitive;
+int snapshotCompress;
+double trestart;
+bool snapshotAsync;
+double tframe, frameXmin, frameXmax, frameYmin, frameYmax;
+int frameNy;
 double Oh, Oha, De, Ec, tmax;
 double tsnap = 0.05; //snapshot saving interval
+bool threadBroken;       // thread has pinched off (see adapt_maxlevel)
+double trestartLast;     // time of the last restart dump
+const char * stopReason; // why the current case stopped
+bool resumed;            // the case continues from its own restart file
 
-char nameOut[128], dumpFile[128], logFile[128];
+char warmStart[256];     // precursor snapshot or case directory, "" if none
+double warmStartTime;    // snapshot time in the precursor, < 0 if unset
+
+char nameOut[128], dumpFile[128], logFile[128], solverFile[128];
 
 /**
-### main()
+### setup_case()
 
-Initializes runtime parameters, configures material properties, and enters
-the Basilisk event loop.
-
-#### Parameters
-- `argc`: Number of CLI arguments.
-- `argv`: Argument vector where `argv[1]` is an optional parameter file path.
+Reads the active parameter set, validates it and prepares the grid, the
+output names and the material properties of one case. The state carried
+by the events between steps is reset too, so every case of an ensemble
+starts as it would in a fresh process.
 
 #### Returns
-- `0`: The simulation runs to completion.
-- `1`: Runtime parameter validation fails before entering the event loop.
+- `0`: The case is ready for `run()`.
+- `1`: Runtime parameter validation fails.
 */
-int main (int argc, char const *argv[])
+static int setup_case (void)
 {
-  const char *paramFile = NULL;
-
-  stokes = true;
-  params_init_from_argv(argc, argv);
-
-  if (argc > 1)
-    paramFile = argv[1];
-
   CaseNo = param_int("CaseNo", 1000);
   MAXlevel = param_int("MAXlevel", 12);
   MINlevel = max(6, (MAXlevel-4)); // minimum grid res
@@ -99,24 +160,96 @@ int main (int argc, char const *argv[])
   Oha = param_double("Oha", 1e-2 * Oh);
   De = param_double("De", 1e30);
   Ec = param_double("Ec", 1e0);
-  dtmax = param_double("dtmax", 1e-5); // BEWARE of this for stability issues.
+  // The controller picks each step below dtCap (see dt-control.h); a
+  // fixed dtmax must be stable at pinch-off, so the two are separate keys.
+  bool dtAdaptive = param_bool("dtAdaptive", false);
+  dtmax = param_double("dtmax", 1e-5);
+  double dtCap = param_double("dtCap", 1e-3);
+  double dtViscous = param_double("dtViscous", 0.);
+  double dtGrowth = param_double("dtGrowth", 1.1);
+
+  int adaptEvery = param_int("adaptEvery", 1);
+  double adaptMove = param_double("adaptMove", 0.5);
+  double adaptNeck = param_double("adaptNeck", 0.1);
+  int adaptIndicator = adapt_indicator(param_string("adaptIndicator", "full"));
+
+  double tolerance = param_double("tolerance", 1e-4);
+  bool tolAdaptive = param_bool("tolAdaptive", false);
+  double tolMax = param_double("tolMax", 1e-3);
+  double tolMin = param_double("tolMin", 1e-6);
+  double tolNeck = param_double("tolNeck", 0.6);
+  int tolIterMax = param_int("tolIterMax", 50);
+  bool solverExtrapolate = param_bool("solverExtrapolate", false);
+  solverLog = param_bool("solverLog", true);
+
+  logFlushEvery = param_int("logFlushEvery", 100);
+  logEchoEvery = param_int("logEchoEvery", 1);
+  logBinary = param_bool("logBinary", false);
+
+  snapshotPrimitive = param_bool("snapshotPrimitive", true);
+  snapshotCompress = snapshot_compression(param_string("snapshotCompress", "none"));
+  trestart = param_double("trestart", 0.05);
+  snapshotAsync = param_bool("snapshotAsync", false);
+  snapshot_async_depth = param_int("snapshotQueue", 2);
+
+  tframe = param_double("tframe", 0.);
+  frameXmin = param_double("frameXmin", 0.);
+  frameXmax = param_double("frameXmax", 4*pi);
+  frameYmin = param_double("frameYmin", 0.);
+  frameYmax = param_double("frameYmax", 2.);
+  frameNy = param_int("frameNy", 400);
+
+  snprintf(warmStart, sizeof(warmStart), "%s", param_string("warmStart", ""));
+  warmStartTime = param_double("warmStartTime", -1.);
 
 
   if (CaseNo < 1000 || MAXlevel <= 0 || Oh <= 0. || Oha < 0. ||
-      De < 0. || Ec < 0. || tmax <= 0. || dtmax <= 0. || dtmax > tmax) {
-    fprintf(ferr, "ERROR: Invalid runtime parameters.\n");
+      De < 0. || Ec < 0. || tmax <= 0. || dtmax <= 0. || dtmax > tmax ||
+      dtCap <= 0. || dtCap > tmax || dtViscous < 0. || dtGrowth <= 1. ||
+      adaptEvery < 1 || adaptMove < 0. || adaptNeck < 0. || adaptIndicator < 0 ||
+      tolerance <= 0. || tolMin <= 0. || tolMax < tolMin || tolNeck <= 0. ||
+      tolIterMax < 1 ||
+      logFlushEvery < 1 || logEchoEvery < 0 ||
+      snapshotCompress < 0 || trestart <= 0. ||
+      snapshot_async_depth < 1 || snapshot_async_depth > SNAPSHOT_ASYNC_MAX ||
+      tframe < 0. || (tframe > 0. && (frameNy <= 0 || frameXmax <= frameXmin ||
+                                      frameYmax <= frameYmin))) {
+    if (pid() == 0)
+      fprintf(ferr, "ERROR: Invalid runtime parameters.\n");
     return 1;
   }
+  if (snapshotAsync && !snapshot_async_available()) {
+    if (pid() == 0)
+      fprintf(ferr, "WARNING: snapshotAsync is not available under MPI,"
+              " writing snapshots and restarts synchronously.\n");
+    snapshotAsync = false;
+  }
 
   L0 = 4*pi;
   init_grid(1 << MINlevel);
 
-  // Create a folder where all simulation snapshots are stored.
-  system("mkdir -p intermediate");
+  // Create a folder where all simulation snapshots are stored. Under MPI,
+  // dump() opens the file on every rank, so the others wait for rank 0.
+  if (pid() == 0) {
+    system("mkdir -p intermediate");
+    if (tframe > 0.)
+      system("mkdir -p insitu");
+  }
+#if _MPI
+  MPI_Barrier (MPI_COMM_WORLD);
+#endif
 
   // Name of the restart file. See writingFiles event.
   sprintf(dumpFile, "restart");
   sprintf(logFile, "c%d-log", CaseNo);
+  sprintf(solverFile, "c%d-solver.csv", CaseNo);
+#if PROFILE_EVENTS
+  // Per-event profile next to the log, appended to after a restart.
+  char profileFile[128];
+  sprintf(profileFile, "c%d-profile.csv", CaseNo);
+  profile_open(profileFile, param_int("profileEvery", 100),
+               access(dumpFile, F_OK) != 0);
+#endif
 
   rho1 = 1.; rho2 = 1e-3;
   mu1 = Oh; mu2 = Oha;
@@ -125,12 +258,155 @@ int main (int argc, char const *argv[])
 
   f.sigma = 1.0;
 
-  TOLERANCE = 1e-4;
+  solver_control_setup(tolerance, tolAdaptive, tolMax, tolMin, tolNeck,
+                       tolIterMax);
+  solver_control_extrapolate(solverExtrapolate);
   CFL = 0.5;
+  dt_control_setup(dtAdaptive, dtCap, dtViscous, dtGrowth);
+  adapt_schedule_setup(adaptEvery, adaptMove, adaptNeck, adaptIndicator);
+
+  // Event state carried between steps starts fresh for every case.
+  tsnap = 0.05;
+  threadBroken = false;
+  trestartLast = -HUGE;
+  igeom.step = -1;
+  stopReason = "end";
+  resumed = false;
+#ifndef LOG_CONFORM_REGIME
+  // Resolved again from this case's De and Ec by two-phaseVE.h.
+  log_conform_regime = LOG_CONFORM_AUTO;
+#endif
+
+  return 0;
+}
+
+/**
+### run_ensemble()
+
+Runs the `[case]` blocks of an ensemble parameter file (see
+`src-local/parse_params.h`) one after another in this process. Case
+`CaseNo` runs in its own directory `c<CaseNo>/`, so logs, snapshots and
+restarts stay separate and a rerun resumes every case from its own
+`restart`. The compiled solver, the process and its field registrations
+are reused; each case re-initializes the tree at its `MINlevel`.
+
+One row per case is appended to `ensemble-summary`:
+
+`CaseNo status i t hm seconds stop regime`
+
+with `status` `ran` or `invalid`, the last iteration and time, the last
+minimum neck radius, the wall-clock time, the stop reason (`tmax`,
+`ke-blowup`, `ke-small` or `end`) and the log-conformation regime the case
+ran in (`full`, `no-relaxation` or `newtonian`).
+
+#### Returns
+- `0` when every case ran, `1` if a case failed validation or its
+  directory cannot be used.
+*/
+static int run_ensemble (int ncases)
+{
+  char top[1024];
+  if (!getcwd(top, sizeof(top))) {
+    fprintf(ferr, "ERROR: cannot read the working directory\n");
+    return 1;
+  }
 
   if (pid() == 0) {
-    fprintf(ferr, "CaseNo=%d MAXlevel=%d De=%g Ec=%g Oh=%g tmax=%g dtmax=%g\n",
-            CaseNo, MAXlevel, De, Ec, Oh, tmax, dtmax);
+    FILE * fp = fopen("ensemble-summary", "w");
+    if (fp) {
+      fprintf(fp, "CaseNo status i t hm seconds stop regime\n");
+      fclose(fp);
+    }
+  }
+
+  int failed = 0;
+  for (int k = 0; k < ncases; k++) {
+    params_select_case(k);
+    int caseNo = param_int("CaseNo", 1000 + k);
+
+    char dir[64];
+    snprintf(dir, sizeof(dir), "c%d", caseNo);
+    if (pid() == 0)
+      mkdir(dir, 0755);
+#if _MPI
+    MPI_Barrier (MPI_COMM_WORLD);
+#endif
+    if (chdir(dir)) {
+      fprintf(ferr, "ERROR: cannot enter case directory %s\n", dir);
+      return 1;
+    }
+
+    timer start = timer_start();
+    int status = setup_case();
+    if (!status) {
+      if (pid() == 0)
+        fprintf(ferr, "Ensemble case %d/%d: CaseNo=%d MAXlevel=%d De=%g Ec=%g"
+                " Oh=%g tmax=%g %s=%g\n", k + 1, ncases,
+                CaseNo, MAXlevel, De, Ec, Oh, tmax,
+                dt_control.enabled ? "dtCap" : "dtmax",
+                dt_control.enabled ? dt_control.cap : dtmax);
+      run();
+    }
+    double seconds = timer_elapsed(start);
+
+    if (chdir(top)) {
+      fprintf(ferr, "ERROR: cannot return to %s\n", top);
+      return 1;
+    }
+    failed |= status;
+
+    if (pid() == 0) {
+      FILE * fp = fopen("ensemble-summary", "a");
+      if (fp) {
+        fprintf(fp, "%d %s %d %g %g %.3f %s %s\n", caseNo,
+                status ? "invalid" : "ran", status ? 0 : iter, status ? 0. : t,
+                status ? 0. : igeom.y_min, seconds,
+                status ? "-" : stopReason,
+                status ? "-" : log_conform_regime_name());
+        fclose(fp);
+      }
+    }
+  }
+  return failed;
+}
+
+/**
+### main()
+
+Initializes runtime parameters, configures material properties, and enters
+the Basilisk event loop. A parameter file with `[case]` blocks runs as an
+ensemble (see `run_ensemble()`).
+
+#### Parameters
+- `argc`: Number of CLI arguments.
+- `argv`: Argument vector where `argv[1]` is an optional parameter file path.
+
+#### Returns
+- `0`: The simulation (or every ensemble case) runs to completion.
+- `1`: Runtime parameter validation fails before entering the event loop.
+*/
+int main (int argc, char const *argv[])
+{
+  const char *paramFile = NULL;
+
+  stokes = true;
+  params_init_from_argv(argc, argv);
+
+  if (argc > 1)
+    paramFile = argv[1];
+
+  int ncases = params_case_count();
+  if (ncases > 0)
+    return run_ensemble(ncases);
+
+  if (setup_case())
+    return 1;
+
+  if (pid() == 0) {
+    fprintf(ferr, "CaseNo=%d MAXlevel=%d De=%g Ec=%g Oh=%g tmax=%g %s=%g\n",
+            CaseNo, MAXlevel, De, Ec, Oh, tmax,
+            dt_control.enabled ? "dtCap" : "dtmax",
+            dt_control.enabled ? dt_control.cap : dtmax);
     if (paramFile != NULL)
       fprintf(ferr, "Loaded parameters from %s\n", paramFile);
     fprintf(ferr, "Logging to %s\n", logFile);
@@ -139,29 +415,101 @@ int main (int argc, char const *argv[])
   run();
 }
 
+/**
+### local_maxlevel()
+
+Deepest level the interface needs for the neck radius `y_min`: at least
+five cells across `y_min`, starting from `level`, up to `MAXlevel`.
+*/
+static int local_maxlevel (double y_min, int level)
+{
+  while (y_min < 5*L0/(1 << level) && level < MAXlevel)
+    level++;
+  return level;
+}
+
+/**
+### warm_start()
+
+Restores the precursor snapshot named by `warmStart` (and `warmStartTime`)
+and refines the interface to the `maxlevelLocal` of this case.
+
+The snapshot brings its own `t`, `i` and tree. Refining the interfacial
+cells prolongates every field with its own operator: the VOF fraction
+with the fraction-aware one of `vof.h`, the velocity, pressure and
+conformation components bilinearly. Bilinear weights are positive, so the
+prolongated conformation tensor stays a convex combination of symmetric
+positive-definite tensors. The stresses, properties and the geometry
+cache are rebuilt from this state at the first step; the regular `adapt`
+event then refines the rest of the flow.
+
+#### Returns
+- `true` on success, `false` if no snapshot can be found or restored.
+*/
+static bool warm_start (void)
+{
+  char name[512];
+  if (warmStartTime >= 0.) {
+    char index[300], file[256];
+    snprintf(index, sizeof(index), "%s/intermediate/snapshots.index", warmStart);
+    if (snapshot_index_find(index, warmStartTime, file, sizeof(file)) < 0.) {
+      diag_log_message("ERROR: no snapshot at or before t = %g in %s",
+                       warmStartTime, index);
+      return false;
+    }
+    snprintf(name, sizeof(name), "%s/%s", warmStart, file);
+  }
+  else
+    snprintf(name, sizeof(name), "%s", warmStart);
+
+  if (!snapshot_restore(name, NULL)) {
+    diag_log_message("ERROR: cannot restore warm-start snapshot %s", name);
+    return false;
+  }
+
+  igeom.step = -1;
+  maxlevelLocal = local_maxlevel(interface_geometry()->y_min, maxlevelLocal);
+  refine (level < maxlevelLocal && f[] > 1e-6 && f[] < 1. - 1e-6);
+  igeom.step = -1;
+
+  diag_log_message("Warm start from %s at t = %g, maxlevelLocal %d",
+                   name, t, maxlevelLocal);
+  return true;
+}
+
 /**
 ## Event: Initialization
 
-Restores from `restart` if available; otherwise initializes the thread
-interface profile.
+Restores from `restart` if available; otherwise warm-starts from the
+`warmStart` precursor if one is given (see `warm_start()`), or initializes
+the thread interface profile.
 */
 event init (t = 0)
 {
-  if (!restore(file = dumpFile))
+  resumed = restore(file = dumpFile);
+  if (solverLog)
+    solver_control_open(solverFile, !resumed);
+  if (resumed)
+    return 0;
+
+  if (warmStart[0]) {
+    if (!warm_start()) {
+      stopReason = "warm-start";
+      return 1;
+    }
+  }
+  else
     fraction(f, (1 - epsilon*sin(x/4) - y));
 }
 
 /**
 ## Adaptive Mesh Refinement
-*/
-scalar Y[], KAPPA[];
 
+`KAPPA`, `Y` and the minimum radius come from the per-step cache of
+`interface-geometry.h`.
+*/
 event adapt_maxlevel (i++) {
-  curvature(f, KAPPA);
-  position (f, Y, {0,1});
-  boundary({Y, KAPPA});
-
-  double y_min = statsf(Y).min;
+  double y_min = interface_geometry()->y_min;
 
   if (y_min <= 0.6){
     tsnap = 0.01;
@@ -174,18 +522,15 @@ event adapt_maxlevel (i++) {
   }//near pinchoff
 
 #if ADAPT_MAXLEVEL // thanks @SaumiliJana
-  static bool broken = false;
-  if (!broken){
-    broken = y_min < 1./(1 << maxlevelLocal);
+  if (!threadBroken){
+    threadBroken = y_min < 1./(1 << maxlevelLocal);
   }
 
-  if(broken){
+  if(threadBroken){
     maxlevelLocal = 10;
     tsnap = 0.05;
   } else {
-    while(((statsf(Y).min)<(5*L0/(1<<maxlevelLocal))) && (maxlevelLocal < MAXlevel)){
-      maxlevelLocal = maxlevelLocal + 1;
-    }
+    maxlevelLocal = local_maxlevel(y_min, maxlevelLocal);
   }
 #else
   maxlevelLocal = MAXlevel;
@@ -195,22 +540,88 @@ event adapt_maxlevel (i++) {
 
 event adapt (i++){
   /**
-  Refine/coarsen on interface, velocity, conformation, and curvature. */
-  adapt_wavelet((scalar *) {f, u.x, u.y, A11, A22, A12, AThTh, KAPPA},
-              (double []) {fErr, VelErr, VelErr, AErr, AErr, AErr, AErr, KErr},
-              maxlevelLocal, MINlevel);
+  Refine/coarsen on interface, velocity, conformation, and curvature, at
+  the cadence of `adapt-schedule.h` (every step near pinch-off). */
+  if (adapt_schedule_due(maxlevelLocal, interface_geometry()->y_min))
+    adapt_schedule_done(adapt_schedule_wavelet(fErr, VelErr, AErr, KErr,
+                                               maxlevelLocal, MINlevel),
+                        maxlevelLocal);
 }
 
 /**
 ## Event: writingFiles
 
-Writes restart state and time-stamped snapshots to `intermediate/`.
+Writes time-stamped snapshots to `intermediate/` and, every `trestart`
+(and at `tmax`), the full restart state.
+
+Snapshots hold only the primitive state by default: the stresses and the
+other derived fields are rebuilt from it at the next step, and the
+post-processing helpers only read `f`, `u` and the conformation tensor.
+
+With `snapshotAsync`, both files are serialized in memory and written by
+the background thread of `snapshot-io.h`, in order and atomically.
+
+Snapshot names carry six decimals of `t`, so snapshots `1e-4` apart near
+pinch-off never share a name. Each snapshot is also listed, with its exact
+time, iteration, size, neck radius and deepest level, in
+`intermediate/snapshots.index` (see `snapshot-io.h`), once it is on disk.
+
+Under MPI, `adapt_wavelet()` rebalances the tree across ranks after every
+adaptation; each restart also logs the resulting leaf counts per rank
+(`max/mean` is the load imbalance).
 */
 event writingFiles (t = 0; t += tsnap; t <= tmax)
 {
-  dump(file = dumpFile);
-  sprintf(nameOut, "intermediate/snapshot-%5.4f", t);
-  dump(file = nameOut);
+  long (* save) (const char *, scalar *, int, const SnapshotRow *) =
+    snapshotAsync ? snapshot_write_async : snapshot_write;
+
+  if (t - trestartLast >= trestart*(1. - 1e-9) || t >= tmax*(1. - 1e-9)) {
+    save(dumpFile, NULL, SNAPSHOT_PLAIN, NULL);
+    trestartLast = t;
+#if _MPI
+    long cells = grid->n, cmin = cells, cmax = cells, ctot = cells;
+    MPI_Allreduce (MPI_IN_PLACE, &cmin, 1, MPI_LONG, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce (MPI_IN_PLACE, &cmax, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce (MPI_IN_PLACE, &ctot, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+    diag_log_message("# t %g ranks %d cells %ld min %ld max %ld imbalance %.3f",
+                     t, npe(), ctot, cmin, cmax, cmax*npe()/(double) ctot);
+#endif
+  }
+
+  scalar * primitive = {f, u.x, u.y, p, A11, A12, A22, AThTh};
+  sprintf(nameOut, "intermediate/snapshot-%.6f", t);
+  SnapshotRow row = snapshot_index_row("intermediate/snapshots.index",
+                                       interface_geometry()->y_min);
+  save(nameOut, snapshotPrimitive ? primitive : NULL, snapshotCompress, &row);
+}
+
+/**
+## Event: insituFrames
+
+With `tframe > 0`, samples `D2c`, `vel` and `trA` (as in
+`postProcess/getData-elastic.c`) on the frame window every `tframe` and
+writes them, with the interface facets, to `insitu/frame-<t>.bin` in the
+`getFrame-elastic` format. `postProcess/Video-generic.py --insitu` renders
+these files without restoring any snapshot.
+*/
+event insituFrames (t = 0; t += (tframe > 0. ? tframe : HUGE); t <= tmax)
+{
+  if (tframe <= 0.)
+    return 0;
+
+  scalar D2c[], vel[], trA[];
+  elastic_derived_fields (D2c, vel, trA, (bool []) {true, true, true});
+
+  char name[128];
+  sprintf(name, "insitu/frame-%.6f.bin", t);
+  FILE * fp = pid() == 0 ? fopen(name, "wb") : NULL;
+  if (pid() == 0 && !fp)
+    fprintf(ferr, "ERROR: cannot open frame file %s\n", name);
+  elastic_write_frame (fp, (scalar *) {D2c, vel, trA}, elastic_field_names, f,
+                       frameXmin, frameYmin, frameXmax, frameYmax, frameNy,
+                       4, false);
+  if (fp)
+    fclose(fp);
 }
 
 /**
@@ -225,72 +636,66 @@ event stopSimulation (t = tmax)
             CaseNo, MAXlevel, De, Ec, Oh);
   /**
   Returning non-zero from an event stops the simulation loop. */
+  stopReason = "tmax";
   return 1;
 }
 
 /**
 ## Event: logWriting
 
-Appends per-iteration diagnostics to `c<CaseNo>-log`.
+Logs per-iteration diagnostics to `c<CaseNo>-log` through the buffered
+writer of `diagnostics-log.h`. Every reduction is computed once per step
+on all ranks (`ke` through `reduction(+:ke)`, `hm` and `vm` through the
+reduced `statsf()`/`normf()`), so every rank sees the same values; only
+rank 0 writes.
 */
 
 event logWriting (i++)
 {
   double ke = 0.;
-  FILE *fp = NULL;
 
   /**
   Compute total kinetic energy in axisymmetric coordinates. */
   foreach (reduction(+:ke))
     ke += (2*pi*y)*(0.5*rho(f[])*(sq(u.x[]) + sq(u.y[])))*sq(Delta);
 
-  position(f, Y, {0, 1});
+  double hm = interface_geometry()->y_min, vm = normf(u.x).max;
 
-  if (pid() == 0) {
-    if (i == 0) {
-      fprintf(ferr, "i dt t ke hm vm\n");
-      fp = fopen(logFile, "w");
-      if (fp == NULL) {
-        fprintf(ferr, "ERROR: cannot open log file %s\n", logFile);
-        exit(1);
-      }
-      fprintf(fp, "CaseNo %d, Level %d, De %g, Ec %g, Oh %g, Oha %g\n",
-              CaseNo, MAXlevel, De, Ec, Oh, Oha);
-      fprintf(fp, "i dt t ke hm vm\n");
-      fprintf(fp, "%d %g %g %g %6.5e %6.5e\n", i, dt, t, ke, statsf(Y).min, normf(u.x).max);
-      fclose(fp);
-    } else {
-      fp = fopen(logFile, "a");
-      if (fp == NULL) {
-        fprintf(ferr, "ERROR: cannot open log file %s\n", logFile);
-        exit(1);
-      }
-      fprintf(fp, "%d %g %g %g %6.5e %6.5e\n", i, dt, t, ke, statsf(Y).min, normf(u.x).max);
-      fclose(fp);
-    }
-    fprintf(ferr, "%d %g %g %g %6.5e %6.5e\n", i, dt, t, ke, statsf(Y).min, normf(u.x).max);
+  if (!diag_log.open) {
+    char preamble[256];
+    snprintf(preamble, sizeof(preamble),
+             "CaseNo %d, Level %d, De %g, Ec %g, Oh %g, Oha %g",
+             CaseNo, MAXlevel, De, Ec, Oh, Oha);
+    diag_log_open(logFile, !resumed, preamble,
+                  (const char *[]) {"i", "dt", "t", "ke", "hm", "vm"}, 6,
+                  logFlushEvery, logEchoEvery, logBinary);
+  }
+  diag_log_row((double []) {i, dt, t, ke, hm, vm},
+               "%d %g %g %g %6.5e %6.5e", i, dt, t, ke, hm, vm);
 
+  if (pid() == 0) {
+    // assert() aborts without running atexit(): flush the buffered rows first.
+    if (!(ke > -1e-10))
+      diag_log_flush();
     assert(ke > -1e-10);
+  }
 
-    if (ke > 1e2 && i > 1e1) {
-      fprintf(ferr, "The kinetic energy blew up. Stopping simulation\n");
-      fp = fopen(logFile, "a");
-      if (fp != NULL) {
-        fprintf(fp, "The kinetic energy blew up. Stopping simulation\n");
-        fclose(fp);
-      }
-      dump(file = dumpFile);
-      return 1;
-    }
-    if (ke < 1e-8 && i > 1e1) {
-      fprintf(ferr, "Kinetic energy too small now. Stopping simulation\n");
-      dump(file = dumpFile);
-      fp = fopen(logFile, "a");
-      if (fp != NULL) {
-        fprintf(fp, "Kinetic energy too small now. Stopping simulation\n");
-        fclose(fp);
-      }
-      return 1;
-    }
+  /**
+  `ke` is reduced over all ranks, so every rank takes the same branch and
+  the final `dump()` is collective. Pending background writes finish
+  first, so no queued restart lands after it. */
+  if (ke > 1e2 && i > 1e1) {
+    diag_log_message("The kinetic energy blew up. Stopping simulation");
+    stopReason = "ke-blowup";
+    snapshot_async_drain();
+    dump(file = dumpFile);
+    return 1;
+  }
+  if (ke < 1e-8 && i > 1e1) {
+    diag_log_message("Kinetic energy too small now. Stopping simulation");
+    stopReason = "ke-small";
+    snapshot_async_drain();
+    dump(file = dumpFile);
+    return 1;
   }
 }
@@ -0,0 +1,248 @@
+/**
+# adapt-schedule.h
+
+Scheduler for the `adapt` event of the simulation cases.
+
+`adapt_wavelet()` used to run at every step on eight fields, paying for
+the wavelet analysis, the tree rebalancing and the reallocation of every
+field each time. The scheduler decides, once per step, whether the mesh
+must be adapted now:
+
+- every `adapt_schedule.every` steps;
+- when the interface may have moved more than `adapt_schedule.move`
+  cells of `maxlevelLocal` since the last adaptation. The displacement is
+  bounded by the sum of `dt` times the largest velocity of the interfacial
+  cells, so the interface never leaves the refined band unnoticed;
+- at every step while the neck radius is below `adapt_schedule.neck`, or
+  when `maxlevelLocal` differs from the level of the last adaptation.
+  Near pinch-off, where `maxlevelLocal` changes quickly, the mesh is thus
+  adapted every step as before.
+
+With `every = 1` (the default) every step adapts.
+
+## Indicators
+
+- `ADAPT_INDICATOR_FULL` (`"full"`): `f`, `u`, the four conformation
+  components and `KAPPA`, as before.
+- `ADAPT_INDICATOR_TRACE` (`"trace"`): `f`, `u`, the mean conformation
+  trace `(A11 + A22 + AThTh)/3` and `KAPPA`. One temporary field replaces
+  four wavelet analyses; the shear component `A12` is not tested.
+
+## Reporting
+
+Every `ADAPT_SCHEDULE_REPORT` steps (and at the end of the run) the number
+of adaptations, of forced ones, and of the cells refined and coarsened
+since the previous report are written through `diag_log_message()`.
+
+## Usage
+
+```c
+#include "adapt-schedule.h"
+...
+  adapt_schedule_setup(param_int("adaptEvery", 1), ...);
+...
+event adapt (i++) {
+  if (adapt_schedule_due(maxlevelLocal, interface_geometry()->y_min))
+    adapt_schedule_done(adapt_schedule_wavelet(...), maxlevelLocal);
+}
+```
+
+## Public API
+
+- `adapt_indicator()`: Parses an indicator set name.
+- `adapt_schedule_setup()`: Sets the cadence and resets the state.
+- `adapt_schedule_due()`: Tells whether this step adapts.
+- `adapt_schedule_wavelet()`: Calls `adapt_wavelet()` on the chosen
+  indicator set.
+- `adapt_schedule_done()`: Records an adaptation and its statistics.
+
+## Change Log
+
+- 2026-10-14: Initial scheduler with step, motion and pinch-off triggers.
+- 2026-10-14: Reports mesh changes to the `CONFORM_BAND` elastic band.
+*/
+
+#ifndef ADAPT_SCHEDULE_H
+#define ADAPT_SCHEDULE_H
+
+#ifndef ADAPT_SCHEDULE_REPORT
+# define ADAPT_SCHEDULE_REPORT 100
+#endif
+
+enum {
+  ADAPT_INDICATOR_FULL = 0,
+  ADAPT_INDICATOR_TRACE
+};
+
+static struct {
+  int every;          // steps between adaptations
+  double move;        // interface motion forcing an adaptation, in cells
+  double neck;        // adapt every step below this neck radius
+  int indicator;      // ADAPT_INDICATOR_*
+  int last_step;      // step of the last adaptation, -1 if none
+  int last_level;     // maxlevelLocal of the last adaptation
+  double moved;       // bound of the interface motion since then
+  int steps, adapts, forced, report_step;
+  long refined, coarsened;
+} adapt_schedule = {.every = 1, .neck = 0.1, .last_step = -1};
+
+/**
+### adapt_indicator()
+
+#### Returns
+- `ADAPT_INDICATOR_FULL` or `ADAPT_INDICATOR_TRACE` for `"full"` and
+  `"trace"`, or `-1` for an unknown name.
+*/
+static int adapt_indicator (const char * name)
+{
+  if (!name || !strcmp (name, "full"))
+    return ADAPT_INDICATOR_FULL;
+  if (!strcmp (name, "trace"))
+    return ADAPT_INDICATOR_TRACE;
+  return -1;
+}
+
+/**
+### adapt_schedule_setup()
+
+#### Parameters
+- `every`: Steps between adaptations (`>= 1`).
+- `move`: Interface motion since the last adaptation, in cells of
+  `maxlevelLocal`, that forces one (`0` disables the trigger).
+- `neck`: Neck radius below which every step adapts.
+- `indicator`: `ADAPT_INDICATOR_FULL` or `ADAPT_INDICATOR_TRACE`.
+*/
+static void adapt_schedule_setup (int every, double move, double neck,
+                                  int indicator)
+{
+  adapt_schedule.every = max (every, 1);
+  adapt_schedule.move = move;
+  adapt_schedule.neck = neck;
+  adapt_schedule.indicator = indicator;
+  adapt_schedule.last_step = -1;
+  adapt_schedule.last_level = 0;
+  adapt_schedule.moved = 0.;
+  adapt_schedule.steps = adapt_schedule.adapts = adapt_schedule.forced = 0;
+  adapt_schedule.report_step = 0;
+  adapt_schedule.refined = adapt_schedule.coarsened = 0;
+}
+
+/**
+### adapt_schedule_report()
+
+Logs the statistics gathered since the previous report and resets them. */
+
+static void adapt_schedule_report (void)
+{
+  if (!adapt_schedule.steps)
+    return;
+  diag_log_message ("adapt at i = %d, t = %g: %d of %d steps (%d forced),"
+                    " %ld cells refined, %ld coarsened", iter, t,
+                    adapt_schedule.adapts, adapt_schedule.steps,
+                    adapt_schedule.forced, adapt_schedule.refined,
+                    adapt_schedule.coarsened);
+  adapt_schedule.steps = adapt_schedule.adapts = adapt_schedule.forced = 0;
+  adapt_schedule.refined = adapt_schedule.coarsened = 0;
+  adapt_schedule.report_step = iter;
+}
+
+/**
+### adapt_schedule_due()
+
+Called once per step, from the `adapt` event. With a motion trigger, adds
+the displacement bound of this step (a global reduction over the
+interfacial cells).
+
+#### Parameters
+- `level`: `maxlevelLocal` of this step.
+- `y_min`: Neck radius of this step.
+
+#### Returns
+- `true` if the mesh must be adapted at this step.
+*/
+static bool adapt_schedule_due (int level, double y_min)
+{
+  adapt_schedule.steps++;
+  if (iter - adapt_schedule.report_step >= ADAPT_SCHEDULE_REPORT)
+    adapt_schedule_report();
+
+  if (adapt_schedule.last_step < 0 || level != adapt_schedule.last_level ||
+      y_min < adapt_schedule.neck) {
+    adapt_schedule.forced++;
+    return true;
+  }
+  if (iter - adapt_schedule.last_step >= adapt_schedule.every)
+    return true;
+
+  if (adapt_schedule.move > 0.) {
+    double umax = 0.;
+    foreach (reduction(max:umax))
+      if (f[] > 1e-6 && f[] < 1. - 1e-6)
+        foreach_dimension()
+          if (fabs(u.x[]) > umax)
+            umax = fabs(u.x[]);
+    adapt_schedule.moved += dt*umax;
+    if (adapt_schedule.moved > adapt_schedule.move*L0/(1 << level)) {
+      adapt_schedule.forced++;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+### adapt_schedule_wavelet()
+
+Adapts on the indicator set of `adapt_schedule.indicator`. The tolerances
+are those of `f`, of each velocity component, of the conformation tensor
+(also used for its trace) and of the curvature. */
+
+static astats adapt_schedule_wavelet (double fErr, double VelErr, double AErr,
+                                      double KErr, int maxlevel, int minlevel)
+{
+  if (adapt_schedule.indicator == ADAPT_INDICATOR_TRACE) {
+    scalar trA[];
+    foreach()
+      trA[] = (A11[] + A22[] + AThTh[])/3.;
+    return adapt_wavelet ((scalar *) {f, u.x, u.y, trA, KAPPA},
+                          (double []) {fErr, VelErr, VelErr, AErr, KErr},
+                          maxlevel, minlevel);
+  }
+  return adapt_wavelet ((scalar *) {f, u.x, u.y, A11, A22, A12, AThTh, KAPPA},
+                        (double []) {fErr, VelErr, VelErr, AErr, AErr, AErr,
+                                     AErr, KErr},
+                        maxlevel, minlevel);
+}
+
+/**
+### adapt_schedule_done()
+
+Records an adaptation at this step, with the statistics returned by
+`adapt_wavelet()` and the level it adapted to. With `CONFORM_BAND`, also
+tells the log-conformation solver whether the mesh changed. */
+
+static void adapt_schedule_done (astats s, int level)
+{
+  adapt_schedule.last_step = iter;
+  adapt_schedule.last_level = level;
+  adapt_schedule.moved = 0.;
+  adapt_schedule.adapts++;
+  adapt_schedule.refined += s.nf;
+  adapt_schedule.coarsened += s.nc;
+#if CONFORM_BAND
+  conform_band_adapted (s);
+#endif
+}
+
+/**
+## Event: adapt_schedule_end
+
+Reports the last interval. `diag_log_end` has closed the log by then, so
+this line only goes to `ferr`. */
+
+event adapt_schedule_end (t = end)
+{
+  adapt_schedule_report();
+}
+
+#endif
@@ -0,0 +1,201 @@
+/**
+# dt-control.h
+
+Stability-aware time-step controller for the simulation cases.
+
+The cases run with `stokes = true`, so `navier-stokes/centered.h` takes
+`dt = dtmax` without any CFL condition, and a fixed `dtmax` had to be
+small enough for the worst moment of the run (pinch-off, deepest mesh).
+Here the cap `dt_control.cap` (the `dtCap` key of the cases) replaces it:
+before every step, `dtmax` is set to the tightest of the following limits.
+
+- `advection`: $\Delta t \le \mathrm{CFL}\,\Delta/|u_f|$ on the faces,
+  as `timestep()` would compute it without `stokes`; the VOF and tracer
+  advection are explicit.
+- `capillary`: $\Delta t \le \sqrt{\rho_m \Delta_{min}^3/(\pi\sigma)}$,
+  the Brackbill limit of `tension.h` (which still applies it
+  afterwards) with $\rho_m = (\rho_1 + \rho_2)/2$.
+- `viscous`: $\Delta t \le c_\mu\,\rho\,\Delta^2/\mu$. The viscous solve
+  is implicit, so this limit is disabled by default (`c_mu = 0`).
+- `elastic`: $\Delta t \le \mathrm{CFL}\,\Delta/c_e$ with the elastic
+  wave speed $c_e = \sqrt{G_p\,\lambda_{max}(\mathbf{A})/\rho}$, where
+  $\lambda_{max}$ is the largest conformation eigenvalue (in-plane or
+  azimuthal), wherever $G_p > 0$ and $\lambda > 0$. The polymeric
+  stress enters the momentum equation explicitly.
+- `dtmax`: the user cap `dt_control.cap`.
+
+The step may grow by at most a factor `dt_control.growth` per step, so a
+sudden relaxation of the limits does not produce a jump in `dt`. Growth is
+measured from the step the controller chose last, not from `dt`: a step
+shortened to land on an event time (`tnext`, every snapshot) would
+otherwise throttle the steps after it.
+
+The active limit is reported through `diag_log_message()` (once the log
+is open) when it changes, at most once every `DT_CONTROL_REPORT` steps,
+so flip-flopping between two comparable limits does not flood the log.
+
+## Requirements
+
+Include after `tension.h`, `two-phaseVE.h`,
+`log-conform-viscoelastic-scalar-2D.h` and `diagnostics-log.h`, so that
+the `stability` event below runs before those of `tension.h` and
+`navier-stokes/centered.h` (Basilisk runs the latest definition of an
+event name first).
+
+## Public API
+
+- `dt_control_setup()`: Enables or disables the controller and sets the
+  cap, the viscous coefficient and the growth factor.
+- `dt_control.limits[]`, `dt_control.active`: Limits and active limit of
+  the last step.
+
+## Change Log
+
+- 2026-10-14: Initial controller with advection, capillary, viscous and
+  elastic limits.
+- 2026-10-14: The cap is the `dtCap` key; `dtmax` stays the fixed step.
+- 2026-10-14: Growth measured from the previous controller step.
+*/
+
+#ifndef DT_CONTROL_H
+#define DT_CONTROL_H
+
+#ifndef DT_CONTROL_REPORT
+# define DT_CONTROL_REPORT 100
+#endif
+
+enum {
+  DT_LIMIT_CAP = 0,
+  DT_LIMIT_ADVECTION,
+  DT_LIMIT_CAPILLARY,
+  DT_LIMIT_VISCOUS,
+  DT_LIMIT_ELASTIC,
+  DT_NLIMITS
+};
+
+static const char * dt_limit_names[DT_NLIMITS] = {
+  "dtmax", "advection", "capillary", "viscous", "elastic"
+};
+
+static struct {
+  bool enabled;
+  double cap;      // user cap (dtCap)
+  double viscous;  // c_mu, 0 disables the viscous limit
+  double growth;   // largest dt ratio between two steps
+  double last;     // dtmax chosen at the previous step, 0 before the first
+  double limits[DT_NLIMITS];
+  int active, reported, reported_step;
+} dt_control = {.growth = 1.1, .active = -1, .reported = -1};
+
+/**
+### dt_control_setup()
+
+#### Parameters
+- `enabled`: Use the controller; otherwise `dtmax` is left untouched.
+- `cap`: Upper bound of the time step (the `dtCap` parameter; the fixed
+  `dtmax` of a run without the controller is a separate key).
+- `viscous`: Coefficient `c_mu` of the viscous limit, `0` disables it.
+- `growth`: Largest ratio between two consecutive steps (`> 1`).
+*/
+static void dt_control_setup (bool enabled, double cap, double viscous,
+                              double growth)
+{
+  dt_control.enabled = enabled;
+  dt_control.cap = cap;
+  dt_control.viscous = viscous;
+  dt_control.growth = growth;
+  dt_control.last = 0.;
+  dt_control.active = dt_control.reported = -1;
+  dt_control.reported_step = 0;
+}
+
+/**
+### dt_control_limits()
+
+Fills `dt_control.limits[]` for the current state. Every limit is a global
+reduction, so all ranks get the same values. */
+
+static void dt_control_limits (void)
+{
+  double dt_adv = HUGE, dmin = HUGE;
+  foreach_face (reduction(min:dt_adv) reduction(min:dmin)) {
+    if (uf.x[] != 0.) {
+      double dta = Delta*cm[]/fabs(uf.x[]);
+      if (dta < dt_adv)
+        dt_adv = dta;
+    }
+    if (fm.x[] > 0. && Delta < dmin)
+      dmin = Delta;
+  }
+
+  double dt_visc = HUGE, dt_el = HUGE;
+  bool viscous = dt_control.viscous > 0.;
+  foreach (reduction(min:dt_visc) reduction(min:dt_el)) {
+    double rhoc = rho(f[]);
+    if (viscous) {
+      double muc = mu(f[]);
+      if (muc > 0. && rhoc*sq(Delta)/muc < dt_visc)
+        dt_visc = rhoc*sq(Delta)/muc;
+    }
+    if (conform_Gp(0,0) > 0. && conform_lambda() > 0.) {
+      double a = (A11[] + A22[])/2.;
+      double b = sqrt (sq(A11[] - A22[])/4. + sq(A12[]));
+      double lmax = max (a + b, AThTh[]);
+      double ce = sqrt (conform_Gp(0,0)*max (lmax, 1.)/rhoc);
+      if (Delta/ce < dt_el)
+        dt_el = Delta/ce;
+    }
+  }
+
+  double sigma = 0.;
+  for (scalar c in interfaces)
+    sigma += c.sigma;
+
+  dt_control.limits[DT_LIMIT_CAP] = dt_control.cap;
+  dt_control.limits[DT_LIMIT_ADVECTION] = CFL*dt_adv;
+  dt_control.limits[DT_LIMIT_CAPILLARY] = sigma > 0. && dmin < HUGE ?
+    sqrt ((rho1 + rho2)/2.*cube(dmin)/(pi*sigma)) : HUGE;
+  dt_control.limits[DT_LIMIT_VISCOUS] = viscous ?
+    dt_control.viscous*dt_visc : HUGE;
+  dt_control.limits[DT_LIMIT_ELASTIC] = CFL*dt_el;
+}
+
+/**
+## Event: stability
+
+Sets `dtmax` to the tightest limit, bounded by the growth factor from the
+previous controller step, and reports changes of the active limit. */
+
+event stability (i++)
+{
+  if (!dt_control.enabled)
+    return 0;
+
+  dt_control_limits();
+  dt_control.active = DT_LIMIT_CAP;
+  for (int k = 1; k < DT_NLIMITS; k++)
+    if (dt_control.limits[k] < dt_control.limits[dt_control.active])
+      dt_control.active = k;
+  dtmax = dt_control.limits[dt_control.active];
+  double previous = dt_control.last > 0. ? dt_control.last :
+    i > 0 && dt > 0. ? dt : HUGE;
+  if (dtmax > dt_control.growth*previous)
+    dtmax = dt_control.growth*previous;
+  dt_control.last = dtmax;
+
+  if (diag_log.open && dt_control.active != dt_control.reported &&
+      (dt_control.reported < 0 ||
+       i - dt_control.reported_step >= DT_CONTROL_REPORT)) {
+    const double * l = dt_control.limits;
+    diag_log_message ("dt limited by %s at i = %d, t = %g: dtmax %g"
+                      " (advection %g, capillary %g, viscous %g, elastic %g,"
+                      " cap %g)", dt_limit_names[dt_control.active], i, t,
+                      dtmax, l[DT_LIMIT_ADVECTION], l[DT_LIMIT_CAPILLARY],
+                      l[DT_LIMIT_VISCOUS], l[DT_LIMIT_ELASTIC],
+                      l[DT_LIMIT_CAP]);
+    dt_control.reported = dt_control.active;
+    dt_control.reported_step = i;
+  }
+}
+
+#endif
@@ -0,0 +1,428 @@
+/**
+# elastic-sampling.h
+
+Derived diagnostics, uniform-window sampling and facet collection shared
+by the post-processing helpers in `postProcess/`.
+
+The including program declares the fields `f`, `u`, `A11`, `A22` and
+`AThTh` (restored from a snapshot or evolved by a simulation case) and
+`#include "fractions.h"` before this header. Frames are written in the
+format of `field-grid-io.h`.
+
+## Derived Fields
+
+- `D2c`: $\log_{10}\left(\|\boldsymbol{\mathcal{D}}\|\right)$ where
+  $\|\boldsymbol{\mathcal{D}}\|=\sqrt{(\boldsymbol{\mathcal{D}}:\boldsymbol{\mathcal{D}})/2}$
+- `vel`: velocity magnitude
+- `trA`: $\log_{10}\left(\mathrm{tr}(\mathbf{A})/3\right)$ where
+  $\mathrm{tr}(\mathbf{A}) = A_{xx} + A_{yy} + A_{\theta\theta}$
+
+## Public API
+
+- `elastic_field_index()`: Maps a field name to its index.
+- `elastic_parse_fields()`: Parses a comma-separated field list.
+- `elastic_derived_fields()`: Evaluates the requested diagnostics.
+- `elastic_sample_window()`: Interpolates a list of scalars onto a window
+  in one pass over the leaves.
+- `elastic_sample_window_located()`: Same result with one `interpolate()`
+  point location per sample (reference implementation).
+- `elastic_collect_cells()`: Collects the leaves inside a window at their
+  native resolution.
+- `elastic_collect_facets()`: Collects the `f` interface segments.
+- `elastic_write_frame()`: Samples a window and writes it with the facets
+  as one frame (serial or MPI).
+*/
+
+#ifndef ELASTIC_SAMPLING_H
+#define ELASTIC_SAMPLING_H
+
+#include "field-grid-io.h"
+
+#define ELASTIC_NFIELDS 3
+
+static const char * elastic_field_names[ELASTIC_NFIELDS] = {"D2c", "vel", "trA"};
+
+/**
+### elastic_field_index()
+
+#### Returns
+- Index of `name` in `elastic_field_names`, or `-1` if unknown.
+*/
+static inline int elastic_field_index (const char * name)
+{
+  for (int k = 0; k < ELASTIC_NFIELDS; k++)
+    if (!strcmp (name, elastic_field_names[k]))
+      return k;
+  return -1;
+}
+
+/**
+### elastic_parse_fields()
+
+Parses a comma-separated list of field names into `selected`.
+
+#### Returns
+- Number of selected fields, or `-1` if a name is unknown or repeated.
+*/
+static int elastic_parse_fields (const char * spec,
+                                 int selected[ELASTIC_NFIELDS])
+{
+  char buf[128];
+  bool seen[ELASTIC_NFIELDS] = {false};
+  int n = 0;
+  snprintf (buf, sizeof(buf), "%s", spec);
+  for (char * tok = strtok (buf, ","); tok; tok = strtok (NULL, ",")) {
+    int k = elastic_field_index (tok);
+    if (k < 0 || seen[k])
+      return -1;
+    seen[k] = true;
+    selected[n++] = k;
+  }
+  return n;
+}
+
+/**
+### elastic_derived_fields()
+
+Evaluates the diagnostics flagged in `want` (indexed as
+`elastic_field_names`) on cell centers. Fields that are not wanted are
+left untouched.
+*/
+static void elastic_derived_fields (scalar D2c, scalar vel, scalar trA,
+                                    const bool want[ELASTIC_NFIELDS])
+{
+  foreach() {
+    if (want[0]) {
+      double D11 = (u.y[0,1] - u.y[0,-1])/(2*Delta);
+      double D22 = (fabs(y) > 1e-14 ? u.y[]/y : 0.);
+      double D33 = (u.x[1,0] - u.x[-1,0])/(2*Delta);
+      double D13 = 0.5*( (u.y[1,0] - u.y[-1,0] + u.x[0,1] - u.x[0,-1])/(2*Delta) );
+      double D_contract = (sq(D11)+sq(D22)+sq(D33)+2.0*sq(D13));
+      D2c[] = sqrt(0.5*D_contract);
+
+      if (D2c[] > 0.){
+        D2c[] = log(D2c[])/log(10);
+      } else {
+        D2c[] = -10;
+      }
+    }
+
+    if (want[1])
+      vel[] = sqrt(sq(u.x[])+sq(u.y[]));
+
+    if (want[2]) {
+      trA[] = (A11[] + A22[]+AThTh[])/3.0;
+
+      if (trA[] > 0.){
+        trA[] = log(trA[])/log(10);
+      } else {
+        trA[] = -10;
+      }
+    }
+  }
+}
+
+/**
+### elastic_bilinear()
+
+Bilinear reconstruction of `s` at `(xp, yp)` from the leaf containing the
+point and its neighbours, as done by `interpolate()` once the leaf is
+located.
+*/
+static inline double elastic_bilinear (Point point, scalar s,
+                                       double xp, double yp)
+{
+  double px = (xp - x)/Delta, py = (yp - y)/Delta;
+  int i = px > 0. ? 1 : -1, j = py > 0. ? 1 : -1;
+  px = fabs(px); py = fabs(py);
+  return ((s[]*(1. - px) + s[i]*px)*(1. - py) +
+          (s[0,j]*(1. - px) + s[i,j]*px)*py);
+}
+
+/**
+### elastic_cell_edges()
+
+Lower and upper edges of the leaf at `point`, from its integer position
+on the tree rather than from `x ± Delta/2`. Multiplying an index by
+`L0/2^level` is exact, so two neighbouring leaves (of any levels) compute
+their shared face as the same double.
+*/
+static inline void elastic_cell_edges (Point point, coord * lo, coord * hi)
+{
+  double h = L0/(1 << point.level);
+  lo->x = X0 + (point.i - GHOSTS)*h;
+  hi->x = X0 + (point.i - GHOSTS + 1)*h;
+  lo->y = Y0 + (point.j - GHOSTS)*h;
+  hi->y = Y0 + (point.j - GHOSTS + 1)*h;
+}
+
+/**
+### elastic_sample_index()
+
+First sample index at or above the face `edge` of a window axis
+starting at `origin` with spacing `step`. The leaf with edges `lo` and
+`hi` owns the indices `[elastic_sample_index (lo), elastic_sample_index
+(hi))`; since the index is a function of the face only, neighbouring
+leaves split the sample points without gaps or overlaps.
+*/
+static inline int elastic_sample_index (double edge, double origin,
+                                        double step)
+{
+  return (int) ceil ((edge - origin)/step - 0.5);
+}
+
+/**
+### elastic_sample_window()
+
+Interpolates every scalar of `list` on the cell centers of a uniform
+`nx x ny` grid covering `[xmin, xmax] x [ymin, ymax]`. Field `k` is
+stored as one contiguous column, value `(i, j)` at
+`field[(k*ny + j)*nx + i]`, matching `field-grid-io.h`.
+
+Rather than locating every sample point from the root of the tree, the
+leaves are visited once: each leaf overlapping the window fills the block
+of sample points that falls inside it, so the cost is one traversal plus
+`nx*ny*len` bilinear evaluations. The owned block of a leaf is derived
+from its edges alone (`elastic_cell_edges()`, `elastic_sample_index()`),
+so a sample point on a face goes to exactly one of the two cells sharing
+it, whatever the roundoff, and the leaves can be processed in parallel.
+Points outside the domain keep `nodata`.
+*/
+static void elastic_sample_window (scalar * list, double xmin, double ymin,
+                                   double xmax, double ymax, int nx, int ny,
+                                   double * field)
+{
+  double Deltax = (xmax - xmin)/nx, Deltay = (ymax - ymin)/ny;
+  long n = (long) nx*ny;
+  int len = list_len (list);
+  for (long k = 0; k < len*n; k++)
+    field[k] = nodata;
+
+  foreach() {
+    coord lo, hi;
+    elastic_cell_edges (point, &lo, &hi);
+    int i0 = max (0, elastic_sample_index (lo.x, xmin, Deltax));
+    int i1 = min (nx, elastic_sample_index (hi.x, xmin, Deltax)) - 1;
+    int j0 = max (0, elastic_sample_index (lo.y, ymin, Deltay));
+    int j1 = min (ny, elastic_sample_index (hi.y, ymin, Deltay)) - 1;
+    if (i0 <= i1 && j0 <= j1)
+      for (int j = j0; j <= j1; j++) {
+        double yp = Deltay*(j+1./2) + ymin;
+        for (int i = i0; i <= i1; i++) {
+          double xp = Deltax*(i+1./2) + xmin;
+          long k = 0;
+          for (scalar s in list)
+            field[k++*n + (long) j*nx + i] = elastic_bilinear (point, s, xp, yp);
+        }
+      }
+  }
+}
+
+/**
+### elastic_sample_window_located()
+
+Same interface and layout as `elastic_sample_window()`, with one
+`interpolate()` call (a point location from the root) per sample point
+and field. Kept as the reference for checking the leaf walk.
+*/
+static void elastic_sample_window_located (scalar * list,
+                                           double xmin, double ymin,
+                                           double xmax, double ymax,
+                                           int nx, int ny, double * field)
+{
+  double Deltax = (xmax - xmin)/nx, Deltay = (ymax - ymin)/ny;
+  for (int i = 0; i < nx; i++) {
+    double x = Deltax*(i+1./2) + xmin;
+    for (int j = 0; j < ny; j++) {
+      double y = Deltay*(j+1./2) + ymin;
+      int k = 0;
+      for (scalar s in list)
+        field[((long) k++*ny + j)*nx + i] = interpolate (s, x, y);
+    }
+  }
+}
+
+/**
+### elastic_collect_cells()
+
+Collects the leaves overlapping `[xmin, xmax] x [ymin, ymax]` at their
+native resolution, which the adaptation keeps finest at the interface.
+The result is a newly allocated array of `(3 + len)*n` doubles holding
+the columns `x`, `y`, `Delta` and then one column per scalar of `list`,
+each of length `n`. The caller frees the array.
+
+#### Returns
+- The cell array (`NULL` when no leaf overlaps the window); `n` is set to
+  the number of cells.
+*/
+static double * elastic_collect_cells (scalar * list,
+                                       double xmin, double ymin,
+                                       double xmax, double ymax, long * n)
+{
+  int len = list_len (list);
+  long size = 0, count = 0;
+  double * rows = NULL;
+  foreach (serial)
+    if (x + Delta/2. > xmin && x - Delta/2. < xmax &&
+        y + Delta/2. > ymin && y - Delta/2. < ymax) {
+      if (count == size) {
+        size = size ? 2*size : 4096;
+        rows = (double *) realloc (rows, (3 + len)*size*sizeof(double));
+      }
+      double * row = rows + (3 + len)*count;
+      row[0] = x; row[1] = y; row[2] = Delta;
+      int k = 3;
+      for (scalar s in list)
+        row[k++] = s[];
+      count++;
+    }
+
+  /**
+  Transpose the rows gathered above into columns. */
+
+  double * cells = NULL;
+  if (count) {
+    cells = (double *) malloc ((3 + len)*count*sizeof(double));
+    for (long c = 0; c < count; c++)
+      for (int k = 0; k < 3 + len; k++)
+        cells[k*count + c] = rows[(3 + len)*c + k];
+  }
+  free (rows);
+  *n = count;
+  return cells;
+}
+
+/**
+### elastic_collect_facets()
+
+Collects the interface segments of `c`, as drawn by `output_facets()`,
+into a newly allocated array of `4*n` doubles `(x0, y0, x1, y1)`.
+The caller frees the array.
+
+#### Returns
+- The segment array (`NULL` when there is no interface); `n` is set to
+  the number of segments.
+*/
+static double * elastic_collect_facets (scalar c, long * n)
+{
+  long size = 0, count = 0;
+  double * seg = NULL;
+  foreach (serial)
+    if (c[] > 1e-6 && c[] < 1. - 1e-6) {
+      coord nf = interface_normal (point, c);
+      double alpha = plane_alpha (c[], nf);
+      coord segment[2];
+      if (facets (nf, alpha, segment) == 2) {
+        if (count == size) {
+          size = size ? 2*size : 1024;
+          seg = (double *) realloc (seg, 4*size*sizeof(double));
+        }
+        seg[4*count]     = x + segment[0].x*Delta;
+        seg[4*count + 1] = y + segment[0].y*Delta;
+        seg[4*count + 2] = x + segment[1].x*Delta;
+        seg[4*count + 3] = y + segment[1].y*Delta;
+        count++;
+      }
+    }
+  *n = count;
+  return seg;
+}
+
+/**
+### elastic_write_frame()
+
+Samples `list` on the `ny`-row window (`nx` follows from the aspect
+ratio), collects the facets of `c` and writes the field grid followed by
+the facet section, tagged with the current `t`, to `fp`. With `framed`,
+the frame is preceded by its `int64` byte count.
+
+Under MPI every rank samples the leaves it owns and the pieces are
+combined on rank 0, which alone writes: samples are reduced with `min`
+(unowned points hold `nodata`) and segments are gathered.
+
+The sampling buffer is kept between calls and only grows.
+
+A `NULL` stream on rank 0 still takes part in the MPI collectives and
+reports an error.
+
+#### Returns
+- `0` on success (and on ranks other than 0), `1` on I/O errors.
+*/
+static int elastic_write_frame (FILE * fp, scalar * list,
+                                const char * const * names, scalar c,
+                                double xmin, double ymin,
+                                double xmax, double ymax,
+                                int ny, int value_bytes, bool framed)
+{
+  static double * field = NULL;
+  static size_t field_size = 0;
+
+  int nx = (int)((xmax - xmin)/((ymax - ymin)/ny));
+  int len = list_len (list);
+  size_t size = (size_t) len*nx*ny;
+  if (size > field_size) {
+    field = (double *) realloc (field, size*sizeof(double));
+    field_size = size;
+  }
+  elastic_sample_window (list, xmin, ymin, xmax, ymax, nx, ny, field);
+
+  long nseg = 0;
+  double * seg = elastic_collect_facets (c, &nseg);
+
+#if _MPI
+  MPI_Reduce (pid() ? field : MPI_IN_PLACE, field, size, MPI_DOUBLE,
+              MPI_MIN, 0, MPI_COMM_WORLD);
+  int nlocal = 4*nseg, * counts = NULL, * displs = NULL;
+  double * all = NULL;
+  if (pid() == 0) {
+    counts = (int *) malloc (2*npe()*sizeof(int));
+    displs = counts + npe();
+  }
+  MPI_Gather (&nlocal, 1, MPI_INT, counts, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (pid() == 0) {
+    long total = 0;
+    for (int r = 0; r < npe(); r++)
+      displs[r] = total, total += counts[r];
+    all = (double *) malloc ((total + 1)*sizeof(double));
+    nseg = total/4;
+  }
+  MPI_Gatherv (seg, nlocal, MPI_DOUBLE, all, counts, displs, MPI_DOUBLE,
+               0, MPI_COMM_WORLD);
+  free (seg);
+  free (counts);
+  seg = all;
+  if (pid() != 0)
+    return 0;
+#endif
+
+  if (!fp) {
+    free (seg);
+    return 1;
+  }
+
+  int status = 0;
+  if (framed) {
+    int64_t nbytes = 8 + 4*sizeof(int32_t) + 4*sizeof(double)
+      + (int64_t) FIELD_GRID_NAME_LEN*len
+      + (int64_t) value_bytes*len*nx*ny
+      + 8 + sizeof(double) + sizeof(int64_t) + 4*sizeof(double)*nseg;
+    status = fwrite (&nbytes, sizeof(int64_t), 1, fp) != 1;
+  }
+
+  if (!status)
+    status = field_grid_write_header (fp, nx, ny, names, len, value_bytes,
+                                      xmin, ymin, xmax, ymax);
+  for (int k = 0; k < len && !status; k++)
+    status = field_grid_write_column (fp, field + (long) k*nx*ny,
+                                      (long) nx*ny, 1, value_bytes);
+  if (!status)
+    status = field_grid_write_facets (fp, t, seg, nseg);
+
+  fflush (fp);
+  free (seg);
+  if (status)
+    fprintf (ferr, "ERROR: failed to write frame products\n");
+  return status ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,266 @@
+/**
+# event-profile.h
+
+Compile-time switchable per-event profiler for the simulation cases.
+
+Build with `-DPROFILE_EVENTS=1` to enable it; otherwise this header
+defines nothing. When enabled, every event action registered with
+Basilisk (solver, module and case events alike) is wrapped, so the
+profile covers `tracer_advection` (log-conformation update and `sf`
+filtering), `acceleration`, `properties`, `adapt`, `adapt_maxlevel`,
+`logWriting`, `writingFiles`, ... without touching their code.
+
+For every event definition (name and `file:line`), the profiler records:
+
+- the number of calls;
+- the wall time spent in its action;
+- the number of leaf cells at each call, summed, so that `cells/calls` is
+  the mean grid size the event saw.
+
+Once per step it also adds the multigrid iterations of the pressure
+projection (`mgp`), the approximate projection (`mgpf`) and the viscous
+solve (`mgu`) of `navier-stokes/centered.h`.
+
+## Output
+
+Every `profile_every` steps, rank 0 appends the statistics gathered since
+the previous write to a CSV file and resets them:
+
+`i,t,maxlevel,event,source,calls,seconds,cells,mg_iterations`
+
+- `maxlevel`: deepest leaf level at the time of the write;
+- `event`, `source`: event name and `file:line` of its definition, or the
+  pseudo-events `mg_projection`, `mg_projection_approx` and `mg_viscous`,
+  whose `calls` is the number of steps and `mg_iterations` the sum of
+  multigrid cycles;
+- `seconds`, `cells`: wall time and summed leaf counts of the interval.
+- with `CONFORM_BAND`, the pseudo-event `conform_band_rebuild` counts the
+  rebuilds of the elastic band in `calls` and their cost in `seconds`
+  (see [log-conform-viscoelastic-scalar-2D.h](log-conform-viscoelastic-scalar-2D.h)).
+
+Timings are those of rank 0 under MPI; cell counts are global.
+
+## Usage
+
+Include after the solver headers, then call `profile_open()` before
+`run()`:
+
+```c
+#include "event-profile.h"
+...
+#if PROFILE_EVENTS
+  profile_open("c1000-profile.csv", 100, true);
+#endif
+```
+
+## Public API
+
+- `profile_open()`: Sets the output file and the write interval.
+- `profile_write()`: Appends and resets the current interval.
+
+## Change Log
+
+- 2026-10-14: Initial per-event profiler.
+- 2026-10-14: Elastic band rebuilds (`conform_band_rebuild`).
+*/
+
+#ifndef EVENT_PROFILE_H
+#define EVENT_PROFILE_H
+
+#ifndef PROFILE_EVENTS
+# define PROFILE_EVENTS 0
+#endif
+
+#if PROFILE_EVENTS
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef PROFILE_MAX_EVENTS
+# define PROFILE_MAX_EVENTS 256
+#endif
+
+typedef struct {
+  Event * event;
+  int (* action) (const int, const double, Event *);
+  long calls;
+  double seconds, cells;
+} ProfileEntry;
+
+static struct {
+  ProfileEntry entries[PROFILE_MAX_EVENTS];
+  int n, every, steps;
+  long mg[3];
+  char path[256];
+  bool fresh, installed;
+} profile = {.every = 100};
+
+static double profile_clock (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+/**
+### profile_action()
+
+Replaces the action of every profiled event. The original action is
+found through the `Event` pointer Basilisk passes to every action. */
+
+static int profile_action (const int i, const double t, Event * ev)
+{
+  for (int k = 0; k < profile.n; k++) {
+    ProfileEntry * e = &profile.entries[k];
+    if (e->event == ev) {
+      double start = profile_clock();
+      int status = e->action (i, t, ev);
+      e->seconds += profile_clock() - start;
+      e->cells += grid->tn;
+      e->calls++;
+      return status;
+    }
+  }
+  return 0;
+}
+
+/**
+### profile_install()
+
+Wraps every registered event action once (events with the same name are
+chained through `next`). Running it again, e.g. for the next case of an
+ensemble, only resets the counters. */
+
+static void profile_install (void)
+{
+  for (int k = 0; k < profile.n; k++) {
+    ProfileEntry * e = &profile.entries[k];
+    e->calls = 0, e->seconds = e->cells = 0.;
+  }
+  profile.steps = 0;
+  profile.mg[0] = profile.mg[1] = profile.mg[2] = 0;
+  if (profile.installed)
+    return;
+
+  for (Event * ev = Events; !ev->last; ev++)
+    for (Event * e = ev; e; e = e->next) {
+      if (e->action == profile_action)
+        continue;
+      if (profile.n >= PROFILE_MAX_EVENTS) {
+        fprintf (ferr, "WARNING: event-profile: more than %d events,"
+                 " %s (%s:%d) is not profiled\n",
+                 PROFILE_MAX_EVENTS, e->name, e->file, e->line);
+        continue;
+      }
+      profile.entries[profile.n++] = (ProfileEntry) {
+        .event = e, .action = e->action
+      };
+      e->action = profile_action;
+    }
+  profile.installed = true;
+}
+
+/**
+### profile_open()
+
+#### Parameters
+- `path`: CSV output file.
+- `every`: Steps between writes (`>= 1`).
+- `fresh`: Truncate `path` and write the header; otherwise append.
+*/
+static void profile_open (const char * path, int every, bool fresh)
+{
+  snprintf (profile.path, sizeof(profile.path), "%s", path);
+  profile.every = max (every, 1);
+  profile.fresh = fresh;
+}
+
+/**
+### profile_write()
+
+Appends the current interval to the CSV file and resets it. Collective:
+every rank must call it. */
+
+static void profile_write (void)
+{
+  int maxlevel = 0;
+  foreach (reduction(max:maxlevel))
+    if (level > maxlevel)
+      maxlevel = level;
+
+  if (pid() == 0 && profile.path[0]) {
+    FILE * fp = fopen (profile.path, profile.fresh ? "w" : "a");
+    if (!fp)
+      fprintf (ferr, "WARNING: cannot write profile %s\n", profile.path);
+    else {
+      if (profile.fresh)
+        fputs ("i,t,maxlevel,event,source,calls,seconds,cells,mg_iterations\n",
+               fp);
+      profile.fresh = false;
+      for (int k = 0; k < profile.n; k++) {
+        ProfileEntry * e = &profile.entries[k];
+        if (!e->calls)
+          continue;
+        const char * file = strrchr (e->event->file, '/');
+        fprintf (fp, "%d,%.10g,%d,%s,%s:%d,%ld,%.6g,%.6g,0\n",
+                 iter, t, maxlevel, e->event->name,
+                 file ? file + 1 : e->event->file, e->event->line,
+                 e->calls, e->seconds, e->cells);
+      }
+      const char * mg[3] = {"mg_projection", "mg_projection_approx",
+                            "mg_viscous"};
+      for (int k = 0; k < 3; k++)
+        fprintf (fp, "%d,%.10g,%d,%s,-,%d,0,0,%ld\n",
+                 iter, t, maxlevel, mg[k], profile.steps, profile.mg[k]);
+#if CONFORM_BAND
+      fprintf (fp, "%d,%.10g,%d,conform_band_rebuild,-,%ld,%.6g,0,0\n",
+               iter, t, maxlevel, conform_band_state.rebuilds,
+               conform_band_state.seconds);
+#endif
+      fclose (fp);
+    }
+  }
+
+  for (int k = 0; k < profile.n; k++) {
+    ProfileEntry * e = &profile.entries[k];
+    e->calls = 0, e->seconds = e->cells = 0.;
+  }
+  profile.steps = 0;
+  profile.mg[0] = profile.mg[1] = profile.mg[2] = 0;
+#if CONFORM_BAND
+  conform_band_state.rebuilds = 0, conform_band_state.seconds = 0.;
+#endif
+}
+
+/**
+## Events
+
+`profile_start` wraps the events at the first step; the events of that
+step which run before it are profiled from the next step on.
+`profile_step` adds the multigrid statistics of the step and writes every
+`profile.every` steps; `profile_end` writes the last interval. */
+
+event profile_start (i = 0)
+{
+  profile_install();
+}
+
+event profile_step (i++)
+{
+  profile.mg[0] += mgp.i;
+  profile.mg[1] += mgpf.i;
+  profile.mg[2] += mgu.i;
+  if (++profile.steps >= profile.every)
+    profile_write();
+}
+
+event profile_end (t = end)
+{
+  if (profile.steps)
+    profile_write();
+}
+
+#endif // PROFILE_EVENTS
+
+#endif
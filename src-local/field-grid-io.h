@@ -0,0 +1,198 @@
+/**
+# field-grid-io.h
+
+Binary container for scalar fields sampled on a uniform grid, shared by
+the post-processing helpers and read by `postProcess/Video-generic.py`.
+
+## Layout
+
+All values use the host byte order (little-endian on every supported
+platform).
+
+| Bytes | Type | Content |
+|-------|------|---------|
+| 8 | `char[8]` | magic `EPOGRID1` |
+| 16 | `int32[4]` | `nx`, `ny`, `nfields`, `value_bytes` (4 or 8) |
+| 32 | `float64[4]` | `xmin`, `ymin`, `xmax`, `ymax` |
+| 16 per field | `char[16]` | NUL-padded field names |
+| `nx*ny*value_bytes` per field | `float32` or `float64` | one column array per field |
+
+Each column array is stored row by row in `y`: value `(i, j)` sits at
+index `j*nx + i`, with cell centers
+`x_i = xmin + (i + 1/2)(xmax - xmin)/nx` and
+`y_j = ymin + (j + 1/2)(ymax - ymin)/ny`.
+
+A facet section may follow the columns:
+
+| Bytes | Type | Content |
+|-------|------|---------|
+| 8 | `char[8]` | magic `EPOFACE1` |
+| 8 | `float64` | snapshot time `t` |
+| 8 | `int64` | number of segments `n` |
+| `32*n` | `float64[n][4]` | segments `(x0, y0, x1, y1)` |
+
+An adaptive cell container can be written instead of the grid, holding
+the leaves of the tree at their native resolution:
+
+| Bytes | Type | Content |
+|-------|------|---------|
+| 8 | `char[8]` | magic `EPOCELL1` |
+| 8 | `int32[2]` | `nfields`, `value_bytes` (4 or 8) |
+| 8 | `int64` | number of cells `n` |
+| 16 per field | `char[16]` | NUL-padded field names |
+| `24*n` | `float64[3][n]` | columns `x`, `y`, `Delta` (cell centers and sizes) |
+| `n*value_bytes` per field | `float32` or `float64` | one column array per field |
+
+## Public API
+
+- `field_grid_write_header()`: Writes the magic, sizes, bounds and names.
+- `field_grid_write_column()`: Writes one field converted to the stored
+  precision.
+- `field_grid_write_facets()`: Writes the facet section.
+- `field_cells_write()`: Writes a complete adaptive cell container.
+*/
+
+#ifndef FIELD_GRID_IO_H
+#define FIELD_GRID_IO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FIELD_GRID_MAGIC "EPOGRID1"
+#define FIELD_GRID_NAME_LEN 16
+#define FIELD_FACETS_MAGIC "EPOFACE1"
+#define FIELD_CELLS_MAGIC "EPOCELL1"
+
+/**
+### field_grid_write_header()
+
+#### Parameters
+- `fp`: Output stream (opened in binary mode).
+- `nx`, `ny`: Number of sampling points along `x` and `y`.
+- `names`, `nfields`: Field names, in the order of the columns that follow.
+- `value_bytes`: `4` for `float32` columns, `8` for `float64` columns.
+- `xmin`, `ymin`, `xmax`, `ymax`: Sampling window.
+
+#### Returns
+- `0` on success, `-1` on a write error.
+*/
+static inline int field_grid_write_header (FILE * fp, int nx, int ny,
+                                           const char * const * names,
+                                           int nfields, int value_bytes,
+                                           double xmin, double ymin,
+                                           double xmax, double ymax)
+{
+  int32_t sizes[4] = {nx, ny, nfields, value_bytes};
+  double bounds[4] = {xmin, ymin, xmax, ymax};
+
+  if (fwrite(FIELD_GRID_MAGIC, 1, 8, fp) != 8 ||
+      fwrite(sizes, sizeof(int32_t), 4, fp) != 4 ||
+      fwrite(bounds, sizeof(double), 4, fp) != 4)
+    return -1;
+
+  for (int k = 0; k < nfields; k++) {
+    char name[FIELD_GRID_NAME_LEN] = {0};
+    strncpy(name, names[k], FIELD_GRID_NAME_LEN - 1);
+    if (fwrite(name, 1, FIELD_GRID_NAME_LEN, fp) != FIELD_GRID_NAME_LEN)
+      return -1;
+  }
+  return 0;
+}
+
+/**
+### field_grid_write_column()
+
+Writes `n` values read from `values` with a stride of `stride` doubles,
+converted to `float` when `value_bytes == 4`.
+
+#### Returns
+- `0` on success, `-1` on a write error.
+*/
+static inline int field_grid_write_column (FILE * fp, const double * values,
+                                           long n, int stride,
+                                           int value_bytes)
+{
+  enum { CHUNK = 4096 };
+  if (value_bytes == 8 && stride == 1)
+    return fwrite(values, sizeof(double), n, fp) == (size_t) n ? 0 : -1;
+
+  for (long start = 0; start < n; start += CHUNK) {
+    long m = n - start < CHUNK ? n - start : CHUNK;
+    if (value_bytes == 4) {
+      float buf[CHUNK];
+      for (long k = 0; k < m; k++)
+        buf[k] = (float) values[(start + k)*stride];
+      if (fwrite(buf, sizeof(float), m, fp) != (size_t) m)
+        return -1;
+    }
+    else {
+      double buf[CHUNK];
+      for (long k = 0; k < m; k++)
+        buf[k] = values[(start + k)*stride];
+      if (fwrite(buf, sizeof(double), m, fp) != (size_t) m)
+        return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+### field_grid_write_facets()
+
+Writes `n` segments stored as `(x0, y0, x1, y1)` quadruplets in `seg`,
+tagged with the snapshot time `t`.
+
+#### Returns
+- `0` on success, `-1` on a write error.
+*/
+static inline int field_grid_write_facets (FILE * fp, double t,
+                                           const double * seg, long n)
+{
+  int64_t count = n;
+  if (fwrite(FIELD_FACETS_MAGIC, 1, 8, fp) != 8 ||
+      fwrite(&t, sizeof(double), 1, fp) != 1 ||
+      fwrite(&count, sizeof(int64_t), 1, fp) != 1)
+    return -1;
+  if (n > 0 && fwrite(seg, sizeof(double), 4*n, fp) != (size_t) (4*n))
+    return -1;
+  return 0;
+}
+
+/**
+### field_cells_write()
+
+Writes `n` cells stored as columns in `cells`: `x`, `y`, `Delta`, then
+one column per field, each of `n` doubles.
+
+#### Returns
+- `0` on success, `-1` on a write error.
+*/
+static inline int field_cells_write (FILE * fp, const char * const * names,
+                                     int nfields, int value_bytes,
+                                     const double * cells, long n)
+{
+  int32_t sizes[2] = {nfields, value_bytes};
+  int64_t count = n;
+  if (fwrite(FIELD_CELLS_MAGIC, 1, 8, fp) != 8 ||
+      fwrite(sizes, sizeof(int32_t), 2, fp) != 2 ||
+      fwrite(&count, sizeof(int64_t), 1, fp) != 1)
+    return -1;
+
+  for (int k = 0; k < nfields; k++) {
+    char name[FIELD_GRID_NAME_LEN] = {0};
+    strncpy(name, names[k], FIELD_GRID_NAME_LEN - 1);
+    if (fwrite(name, 1, FIELD_GRID_NAME_LEN, fp) != FIELD_GRID_NAME_LEN)
+      return -1;
+  }
+
+  if (n > 0 && fwrite(cells, sizeof(double), 3*n, fp) != (size_t) (3*n))
+    return -1;
+  for (int k = 0; k < nfields; k++)
+    if (n > 0 &&
+        field_grid_write_column(fp, cells + (3 + k)*n, n, 1, value_bytes))
+      return -1;
+  return 0;
+}
+
+#endif
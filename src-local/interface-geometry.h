@@ -0,0 +1,92 @@
+/**
+# interface-geometry.h
+
+Per-timestep cache of the interface geometry shared by adaptivity,
+snapshot cadence and logging.
+
+`curvature()`, `position()` and `statsf()` are each a full pass over the
+grid, plus a global reduction in parallel runs. The simulation cases used
+to evaluate them separately in `adapt_maxlevel`, in its refinement
+while loop, and in `logWriting`. Here they are computed at most once per
+iteration `i`, and consumers read the cached values.
+
+The including file must declare the volume fraction `f` and include
+`curvature.h` (pulled in by `tension.h`). Include this header after the
+solver headers, so that the `interface_geometry` event is scheduled after
+the interface has been advected for the step.
+
+## Cached Quantities
+
+- `KAPPA`: interface curvature (height functions).
+- `Y`: interface `y` position, i.e. the local thread radius.
+- `igeom.Y`: `statsf(Y)` for the step; `igeom.y_min` is the minimum neck
+  radius.
+
+## Public API
+
+- `interface_geometry()`: Returns the cache for the current iteration,
+  computing it on first use.
+
+## Change Log
+
+- 2026-10-14: Initial cache replacing repeated evaluations in both cases.
+- 2026-10-14: `KAPPA` and `Y` left out of dumps with `LEAN_FIELDS`.
+*/
+
+#ifndef INTERFACE_GEOMETRY_H
+#define INTERFACE_GEOMETRY_H
+
+scalar Y[], KAPPA[];
+
+typedef struct {
+  int step;      // iteration the cache was built for, -1 if never
+  stats Y;       // statsf(Y)
+  double y_min;  // minimum interface radius
+} InterfaceGeometry;
+
+InterfaceGeometry igeom = {.step = -1};
+
+/**
+With `LEAN_FIELDS` (see `log-conform-viscoelastic-scalar-2D.h`), `KAPPA`
+and `Y` are not written to dumps: the cache rebuilds them before their
+first use after a restore. */
+
+#if LEAN_FIELDS
+event defaults (i = 0) {
+  KAPPA.nodump = Y.nodump = true;
+}
+#endif
+
+/**
+### interface_geometry()
+
+#### Returns
+- The cached geometry of iteration `iter` (`i` inside events), recomputing
+  `KAPPA`, `Y` and their reductions if the cache belongs to another
+  iteration.
+*/
+static const InterfaceGeometry * interface_geometry (void)
+{
+  if (igeom.step != iter) {
+    curvature (f, KAPPA);
+    position (f, Y, {0,1});
+    boundary ({Y, KAPPA});
+    igeom.Y = statsf (Y);
+    igeom.y_min = igeom.Y.min;
+    igeom.step = iter;
+  }
+  return &igeom;
+}
+
+/**
+## Event: interface_geometry
+
+Builds the cache once per step, ahead of the consumers defined by the
+case file. */
+
+event interface_geometry (i++)
+{
+  interface_geometry();
+}
+
+#endif
@@ -16,6 +16,15 @@ viscoelastic flows.
 - 2024-11-03: Axisymmetric mirror of 3D scalar version.
 - 2024-11-14: Infinite Deborah number support.
 - 2024-11-23: Documentation updates.
+- 2026-10-14: Optional fused kernel (`FUSED_LOG_CONFORM`).
+- 2026-10-14: Branch-free, batched 2x2 diagonalization.
+- 2026-10-14: Newtonian and infinite-De regimes (`log_conform_regime`).
+- 2026-10-14: Optional elastic-band restriction (`CONFORM_BAND`).
+- 2026-10-14: Optional stress-free storage (`LEAN_FIELDS`).
+- 2026-10-14: The band is rebuilt only after mesh changes or once the
+  interface may have left its halo.
+- 2026-10-14: Band motion bound from the current velocity, with a safety
+  factor and a periodic rebuild.
 
 ## Future Work
 
@@ -26,7 +35,7 @@ viscoelastic flows.
 
 Vatsal Sanjay (vatsal.sanjay@comphy-lab.org)
 CoMPhy Lab
-Last updated: 2024-11-23
+Last updated: 2026-10-14
 */
 
 /**
@@ -164,10 +173,126 @@ TODO:
 (const) scalar Gp = unity; // elastic modulus
 (const) scalar lambda = unity; // relaxation time
 
+/**
+## Lean fields
+
+By default the polymeric stress $\mathbf{T} = G_p(\mathbf{A} -
+\mathbf{I})$ is stored in `T11`, `T12`, `T22` (and `T_ThTh`), and $G_p$,
+$\lambda$ in the fields of [two-phaseVE.h](two-phaseVE.h). Every one is
+one more double per cell, prolongated and restricted by each
+`adapt_wavelet()`.
+
+With `LEAN_FIELDS` (`qcc -DLEAN_FIELDS=1 ...`), none of them is stored:
+
+- the `acceleration` event evaluates $\mathbf{T}$ from $\mathbf{A}$ at
+  each stencil point;
+- $G_p$ and $\lambda$ are evaluated from the phase field
+  `conform_phase` (the filtered volume fraction `sf`, set by
+  two-phaseVE.h) through `conform_modulus()` and
+  `conform_relaxation()`, which two-phaseVE.h defines.
+
+$G_p$ and $\lambda$ then follow the phase field of the current step
+rather than that of the previous `properties` event, a difference of one
+step of interface motion. Dumps of the two modes hold different fields,
+so restarts do not carry over between them.
+
+The kernels read $G_p$, $\lambda$ and $\mathbf{T}$ through the
+`conform_*()` accessors below, which map to the stored fields otherwise. */
+
+#ifndef LEAN_FIELDS
+# define LEAN_FIELDS 0
+#endif
+
+#if LEAN_FIELDS
+(const) scalar conform_phase = zeroc; // phase field for Gp and lambda
+static double conform_modulus (double phase);
+static double conform_relaxation (double phase);
+# define conform_Gp(i,j) conform_modulus (conform_phase[i,j])
+# define conform_lambda() conform_relaxation (conform_phase[])
+# define conform_T11(i,j) (conform_Gp(i,j)*(A11[i,j] - 1.))
+# define conform_T12(i,j) (conform_Gp(i,j)*A12[i,j])
+# define conform_T22(i,j) (conform_Gp(i,j)*(A22[i,j] - 1.))
+# define conform_TThTh(i,j) (conform_Gp(i,j)*(AThTh[i,j] - 1.))
+#else
+# define conform_Gp(i,j) Gp[i,j]
+# define conform_lambda() lambda[]
+# define conform_T11(i,j) T11[i,j]
+# define conform_T12(i,j) T12[i,j]
+# define conform_T22(i,j) T22[i,j]
+# define conform_TThTh(i,j) T_ThTh[i,j]
+#endif
+
+/**
+## Rheology regime
+
+Two limits of the model need less work than the general case:
+
+- `LOG_CONFORM_NEWTONIAN`: no elastic stress ($G_p = 0$ or
+  $\lambda = 0$ everywhere, i.e. `Ec = 0` or `De = 0`). $\mathbf{A}$
+  stays at $\mathbf{I}$, so the conformation solve and the elastic
+  acceleration are skipped entirely.
+- `LOG_CONFORM_NO_RELAXATION`: $\lambda \to \infty$ (`De = 1e30`) in
+  every elastic phase. Step (c) reduces to $\mathbf{A}^{n+1} =
+  e^{\Psi}$ where $\lambda > 0$ and no `exp(-dt/lambda)` is evaluated.
+
+`LOG_CONFORM_AUTO` (the default) lets [two-phaseVE.h](two-phaseVE.h)
+pick the regime from the phase properties when the run starts; a process
+running several cases must reset it to `LOG_CONFORM_AUTO` before each
+`run()`. A case can also set `log_conform_regime` before `run()`, or fix it at compile
+time with e.g. `-DLOG_CONFORM_REGIME=LOG_CONFORM_NEWTONIAN` so that the
+other branches are removed by the compiler. */
+
+enum {
+  LOG_CONFORM_AUTO = -1,
+  LOG_CONFORM_FULL = 0,
+  LOG_CONFORM_NO_RELAXATION,
+  LOG_CONFORM_NEWTONIAN
+};
+
+#ifdef LOG_CONFORM_REGIME
+# define log_conform_regime LOG_CONFORM_REGIME
+#else
+int log_conform_regime = LOG_CONFORM_AUTO;
+#endif
+
+static const char * log_conform_regime_names[] = {
+  "full", "no-relaxation", "newtonian"
+};
+
+/**
+### log_conform_regime_name()
+
+#### Returns
+- The name of the current regime, or `"auto"` before it is resolved. */
+
+static inline const char * log_conform_regime_name (void)
+{
+  return log_conform_regime == LOG_CONFORM_AUTO ? "auto" :
+    log_conform_regime_names[log_conform_regime];
+}
+
+/**
+### log_conform_int_factor()
+
+Integration factor of step (c) for relaxation time `lambda` and time
+step `dt`: zero without memory, one without relaxation. */
+
+static inline double log_conform_int_factor (double lambda, double dt)
+{
+  if (log_conform_regime == LOG_CONFORM_NO_RELAXATION)
+    return lambda > 0. ? 1. : 0.;
+  return (lambda != 0. ? (lambda == 1e30 ? 1: exp(-dt/lambda)): 0.);
+}
+
 scalar A11[], A12[], A22[]; // conformation tensor
+#if AXI
+scalar AThTh[];
+#endif
+#if !LEAN_FIELDS
 scalar T11[], T12[], T22[]; // stress tensor
 #if AXI
-scalar AThTh[], T_ThTh[];
+scalar T_ThTh[];
+#endif
 #endif
 
 event defaults (i = 0) {
@@ -182,16 +307,22 @@ event defaults (i = 0) {
       s[] = 1.;
     }
   }
-  for (scalar s in {T11, T12, T22, A12}) {
+  foreach()
+    A12[] = 0.;
+#if AXI
+  foreach()
+    AThTh[] = 1.;
+#endif
+
+#if !LEAN_FIELDS
+  for (scalar s in {T11, T12, T22}) {
     foreach(){
       s[] = 0.;
     }
   }
 #if AXI
-  foreach(){
+  foreach()
     T_ThTh[] = 0;
-    AThTh[] = 1.;
-  }
 #endif
 
   for (scalar s in {T11, T12, T22}) {
@@ -200,6 +331,7 @@ event defaults (i = 0) {
 	      s[right] = neumann(0);
       }
   }
+#endif
 
   for (scalar s in {A11, A12, A22}) {
     if (s.boundary[left] != periodic_bc) {
@@ -209,7 +341,9 @@ event defaults (i = 0) {
   }
 
 #if AXI
+#if !LEAN_FIELDS
   T12[bottom] = dirichlet (0.);
+#endif
   A12[bottom] = dirichlet (0.);
 #endif
 }
@@ -275,6 +409,72 @@ static void diagonalization_2D (pseudo_v * Lambda, pseudo_t * R, pseudo_t * A)
   }
 }
 
+/**
+### Branch-free and batched diagonalization
+
+`diagonalization_2D()` returns early in the near-diagonal case and walks
+the eigenpairs with a pointer loop, which prevents vectorization.
+`diagonalization_2D_lane()` computes the same eigenpairs for one tensor
+with selects instead of branches: the near-diagonal lanes
+($A_{12}^2 < 10^{-15}$) are masked to $\mathbf{R} = \mathbf{I}$,
+$\Lambda = (A_{11}, A_{22})$, exactly as in `diagonalization_2D()`. The
+discriminant is written as $(A_{11} - A_{22})^2/4 + A_{12}^2$, which is
+non-negative by construction. */
+
+static inline void diagonalization_2D_lane (double a11, double a12, double a22,
+                                            double * l1, double * l2,
+                                            double * rxx, double * rxy,
+                                            double * ryx, double * ryy)
+{
+  bool diag = sq(a12) < 1e-15;
+  double b = diag ? 1. : a12; // keeps the masked lanes finite
+  double h = (a11 + a22)/2.;
+  double d = sqrt(sq(a11 - a22)/4. + sq(a12));
+  double e1 = h + d, e2 = h - d;
+  double m1 = sqrt(sq(b) + sq(e1 - a11));
+  double m2 = sqrt(sq(b) + sq(e2 - a11));
+
+  *l1 = diag ? a11 : e1;
+  *l2 = diag ? a22 : e2;
+  *rxx = diag ? 1. : b/m1;
+  *ryx = diag ? 0. : (e1 - a11)/m1;
+  *rxy = diag ? 0. : b/m2;
+  *ryy = diag ? 1. : (e2 - a11)/m2;
+}
+
+/**
+`diagonalization_2D_nobranch()` is the drop-in, single-cell form used by
+the fused kernel. */
+
+static inline void diagonalization_2D_nobranch (pseudo_v * Lambda, pseudo_t * R,
+                                                pseudo_t * A)
+{
+  diagonalization_2D_lane (A->x.x, A->x.y, A->y.y, &Lambda->x, &Lambda->y,
+                           &R->x.x, &R->x.y, &R->y.x, &R->y.y);
+}
+
+/**
+`diagonalization_2D_batch()` diagonalizes `n` tensors stored as
+structure-of-arrays lanes (`a11`, `a12`, `a22`) and writes the
+eigenvalues and the columns of $\mathbf{R}$ to separate lanes. The loop
+body has no branches, so `#pragma omp simd` (or plain `-O3
+-march=native`) maps it onto the vector units, e.g. eight lanes per
+instruction with AVX-512. */
+
+static void diagonalization_2D_batch (int n,
+                                      const double * restrict a11,
+                                      const double * restrict a12,
+                                      const double * restrict a22,
+                                      double * restrict l1, double * restrict l2,
+                                      double * restrict rxx, double * restrict rxy,
+                                      double * restrict ryx, double * restrict ryy)
+{
+#pragma omp simd
+  for (int k = 0; k < n; k++)
+    diagonalization_2D_lane (a11[k], a12[k], a22[k], &l1[k], &l2[k],
+                             &rxx[k], &rxy[k], &ryx[k], &ryy[k]);
+}
+
 /**
 The stress tensor depends on previous instants and has to be
 integrated in time. In the log-conformation scheme the advection of
@@ -298,9 +498,15 @@ tensor $\mathbf{A}$). In an Oldroyd-B viscoelastic fluid, the model is
 $$
 \partial_t \mathbf{A} = -\frac{\mathbf{f}_r (\mathbf{A})}{\lambda}
 $$
+
+### Reference kernel
+
+`log_conform_reference()` is the original implementation of steps
+(a)--(c). It is kept as the default and as the baseline of the
+optimized kernel below.
 */
 
-event tracer_advection(i++)
+static void log_conform_reference (void)
 {
   scalar Psi11 = A11;
   scalar Psi12 = A12;
@@ -350,6 +556,7 @@ event tracer_advection(i++)
     if (Lambda.x <= 0. || Lambda.y <= 0.) {
       fprintf(ferr, "Negative eigenvalue detected: Lambda.x = %g, Lambda.y = %g\n", Lambda.x, Lambda.y);
       fprintf(ferr, "x = %g, y = %g\n", x, y);
+      // exit() (not abort()) so that atexit() handlers flush buffered logs.
       exit(1);
     }
 
@@ -497,7 +704,7 @@ event tracer_advection(i++)
     $$
     */
 
-    double intFactor = (lambda[] != 0. ? (lambda[] == 1e30 ? 1: exp(-dt/lambda[])): 0.);
+    double intFactor = log_conform_int_factor (conform_lambda(), dt);
 
 #if AXI
       Aqq = (1. - intFactor) + intFactor*exp(Psiqq[]);
@@ -512,16 +719,344 @@ event tracer_advection(i++)
       $\mathbf{A}^{n+1}$.  */
 
     A12[] = A.x.y;
-    T12[] = Gp[]*A.x.y;
 #if AXI
       AThTh[] = Aqq;
-      T_ThTh[] = Gp[]*(Aqq - 1.);
 #endif
-
     A11[] = A.x.x;
-    T11[] = Gp[]*(A.x.x - 1.);
     A22[] = A.y.y;
+
+#if !LEAN_FIELDS
+    T12[] = Gp[]*A.x.y;
+#if AXI
+      T_ThTh[] = Gp[]*(Aqq - 1.);
+#endif
+    T11[] = Gp[]*(A.x.x - 1.);
     T22[] = Gp[]*(A.y.y - 1.);
+#endif
+  }
+}
+
+/**
+### Elastic band
+
+With `CONFORM_BAND` set to a halo width $N > 0$ (e.g.
+`qcc -DCONFORM_BAND=3 ...`), step (a) is restricted to the cells where
+the relaxation time is non-zero (i.e. `sf > TOLelastic` in the elastic
+phase of [two-phaseVE.h](two-phaseVE.h)) dilated by $N$ cells. Outside
+this band $\lambda = 0$, step (c) resets $\mathbf{A}$ to $\mathbf{I}$ in
+any case, and $\Psi$ is simply set to zero before advection. The BCG
+stencil reaches two cells upwind, so any $N \geq 2$ reproduces the
+unrestricted result in the elastic phase.
+
+The band is stored as the mask `conform_band` (prolongated and
+restricted by `adapt_wavelet()`, so it stays a superset of the band on
+refined cells) and rebuilt by `conform_band_update()` only when it may no
+longer cover the elastic phase plus the two-cell BCG stencil:
+
+- after an adaptation that changed the mesh, which the case reports with
+  `conform_band_adapted()` (as [adapt-schedule.h](adapt-schedule.h) does).
+  Without such a report, every `adapt` event marks the band stale;
+- when the elastic phase, which moves with the interface, may have moved
+  more than the spare halo $(N - 2)\,\Delta_{min}$ since the last
+  rebuild. The displacement is bounded by the sum over the steps of
+  `CONFORM_BAND_SAFETY` times `dt` times the largest velocity in the
+  band. That velocity is reduced at the start of every step, before the
+  decision, so a sudden acceleration near pinch-off is seen at once;
+  the safety factor covers its growth within the step;
+- every `CONFORM_BAND_EVERY` steps regardless.
+
+A halo of $N = 4$ to $6$ lets the band last for several steps; with
+$N = 2$ it is rebuilt whenever the interface moves. The number of
+rebuilds and their cost are reported by
+[event-profile.h](event-profile.h) as the pseudo-event
+`conform_band_rebuild`; compare the `tracer_advection` time of a profiled
+run with and without `CONFORM_BAND` to see what the band saves. It is
+only implemented in the fused kernel, which it selects.
+
+The band is off by default. `tests/conform-band.sh` runs the same case
+with the band and with the full update and compares their logs. */
+
+#ifndef CONFORM_BAND
+# define CONFORM_BAND 0
+#endif
+#ifndef CONFORM_BAND_SAFETY
+# define CONFORM_BAND_SAFETY 2.
+#endif
+#ifndef CONFORM_BAND_EVERY
+# define CONFORM_BAND_EVERY 10
+#endif
+
+#if CONFORM_BAND
+scalar conform_band[];
+
+static struct {
+  bool stale;       // rebuild before the next step (a)
+  bool reported;    // the case reports mesh changes
+  double moved;     // bound of the interface motion since the rebuild
+  double step;      // bound of the interface motion in this step
+  int steps;        // steps since the rebuild
+  long rebuilds;    // since the last reset by event-profile.h
+  double seconds;
+} conform_band_state = {.stale = true};
+
+event defaults (i = 0) {
+  conform_band.nodump = true;
+  conform_band_state.stale = true;
+}
+
+static void conform_band_update (void)
+{
+  timer start = timer_start();
+  foreach()
+    conform_band[] = conform_lambda() != 0.;
+
+  for (int n = 0; n < CONFORM_BAND; n++) {
+    scalar grown[];
+    foreach() {
+      double b = 0.;
+      foreach_neighbor(1)
+        b = max (b, conform_band[]);
+      grown[] = b > 0.;
+    }
+    foreach()
+      conform_band[] = grown[];
+  }
+  conform_band_state.stale = false;
+  conform_band_state.moved = 0.;
+  conform_band_state.steps = 0;
+  conform_band_state.rebuilds++;
+  conform_band_state.seconds += timer_elapsed (start);
+}
+
+/**
+#### conform_band_adapted()
+
+Reports the statistics of an `adapt_wavelet()` call. The band is rebuilt
+at the next step only if cells were refined or coarsened. */
+
+static void conform_band_adapted (astats s)
+{
+  conform_band_state.reported = true;
+  if (s.nf || s.nc)
+    conform_band_state.stale = true;
+}
+
+event adapt (i++) {
+  if (!conform_band_state.reported)
+    conform_band_state.stale = true;
+}
+
+/**
+#### conform_band_due()
+
+Whether the band must be rebuilt before the step (a) of this step, given
+the displacement bound of this step from the current velocity in the band
+(one reduction over the grid, without any stencil). */
+
+static bool conform_band_due (void)
+{
+  double umax = 0.;
+  foreach (reduction(max:umax))
+    if (conform_band[] > 0.)
+      foreach_dimension()
+        if (fabs(u.x[]) > umax)
+          umax = fabs(u.x[]);
+  conform_band_state.step = CONFORM_BAND_SAFETY*dt*umax;
+
+  if (conform_band_state.stale ||
+      conform_band_state.steps >= CONFORM_BAND_EVERY)
+    return true;
+  double spare = (CONFORM_BAND - 2)*L0/(1 << depth());
+  return conform_band_state.moved + conform_band_state.step > spare;
+}
+#endif
+
+/**
+### Fused kernel
+
+`log_conform_fused()` performs the same split steps (a)--(c) with less
+work per cell:
+
+- $\mathbf{A}$ is diagonalized exactly once per sweep and the
+  eigen-decomposition is reused for both $\Psi$ and the upper
+  convective term, without zero-initializing `R`, `Lambda`, `B` and `M`
+  (every component is overwritten by the diagonalization or below).
+- $\log \Lambda$ (and $e^{\Lambda}$ in the second sweep) is evaluated
+  once per eigenvalue instead of once per tensor component.
+- The diagonalization is the branch-free `diagonalization_2D_nobranch()`.
+- The four velocity differences are read once and shared by
+  $\mathbf{M}$ and $\mathbf{B}$.
+- Cells with a vanishing integration factor (no relaxation memory,
+  e.g. the Newtonian gas) are reset to $\mathbf{I}$ without a second
+  diagonalization.
+- With `CONFORM_BAND`, step (a) is skipped outside the elastic band.
+
+Up to round-off, the result is identical to `log_conform_reference()`.
+This can be checked with `benchmarks/log-conform-kernel.c`, which also
+reports the per-cell cost of both kernels. */
+
+/**
+#### log_conform_psi_step()
+
+Step (a) of the fused kernel for one cell: $\Psi = \log \mathbf{A}$
+plus the upper convective term. $\Psi$ overwrites $\mathbf{A}$ in place. */
+
+static inline void log_conform_psi_step (Point point)
+{
+  scalar Psi11 = A11;
+  scalar Psi12 = A12;
+  scalar Psi22 = A22;
+#if AXI
+  scalar Psiqq = AThTh;
+#endif
+
+  pseudo_t A = {{A11[], A12[]}, {A12[], A22[]}}, R;
+  pseudo_v Lambda;
+  diagonalization_2D_nobranch (&Lambda, &R, &A);
+
+  if (Lambda.x <= 0. || Lambda.y <= 0.) {
+    fprintf(ferr, "Negative eigenvalue detected: Lambda.x = %g, Lambda.y = %g\n", Lambda.x, Lambda.y);
+    fprintf(ferr, "x = %g, y = %g\n", x, y);
+    // exit() (not abort()) so that atexit() handlers flush buffered logs.
+    exit(1);
+  }
+
+  pseudo_v logL = {log(Lambda.x), log(Lambda.y)};
+  double psi11 = sq(R.x.x)*logL.x + sq(R.x.y)*logL.y;
+  double psi12 = R.x.x*R.y.x*logL.x + R.y.y*R.x.y*logL.y;
+  double psi22 = sq(R.y.y)*logL.y + sq(R.y.x)*logL.x;
+
+  /**
+  Centered differences of the velocity, $2\Delta\,\partial_j u_i$. */
+
+  double dxux = u.x[1] - u.x[-1], dyux = u.x[0,1] - u.x[0,-1];
+  double dxuy = u.y[1] - u.y[-1], dyuy = u.y[0,1] - u.y[0,-1];
+
+  double Bxx, Bxy, Byy, OM = 0.;
+  if (fabs(Lambda.x - Lambda.y) <= 1e-20) {
+    Bxy = (dxuy + dyux)/(4.*Delta);
+    Bxx = dxux/(2.*Delta);
+    Byy = dyuy/(2.*Delta);
+  } else {
+    double Mxx = (sq(R.x.x)*dxux + sq(R.y.x)*dyuy +
+                  R.x.x*R.y.x*(dyux + dxuy))/(2.*Delta);
+    double Myy = (sq(R.y.y)*dyuy + sq(R.x.y)*dxux +
+                  R.y.y*R.x.y*(dxuy + dyux))/(2.*Delta);
+    double Mxy = (R.x.x*R.x.y*dxux + R.x.y*R.y.x*dxuy +
+                  R.x.x*R.y.y*dyux + R.y.x*R.y.y*dyuy)/(2.*Delta);
+    double Myx = (R.y.y*R.y.x*dyuy + R.y.x*R.x.y*dyux +
+                  R.y.y*R.x.x*dxuy + R.x.y*R.x.x*dxux)/(2.*Delta);
+
+    double omega = (Lambda.y*Mxy + Lambda.x*Myx)/(Lambda.y - Lambda.x);
+    OM = (R.x.x*R.y.y - R.x.y*R.y.x)*omega;
+
+    Bxy = Mxx*R.x.x*R.y.x + Myy*R.y.y*R.x.y;
+    Bxx = Mxx*sq(R.x.x) + Myy*sq(R.x.y);
+    Byy = Myy*sq(R.y.y) + Mxx*sq(R.y.x);
+  }
+
+  Psi12[] = psi12 + dt*(2.*Bxy + OM*(psi22 - psi11));
+  Psi11[] = psi11 + 2.*dt*(Bxx + psi12*OM);
+  Psi22[] = psi22 + 2.*dt*(Byy - psi12*OM);
+
+#if AXI
+  Psiqq[] = log (AThTh[]) + dt*2.*u.y[]/max(y, 1e-20);
+#endif
+}
+
+static void log_conform_fused (void)
+{
+  scalar Psi11 = A11;
+  scalar Psi12 = A12;
+  scalar Psi22 = A22;
+#if AXI
+  scalar Psiqq = AThTh;
+#endif
+
+#if CONFORM_BAND
+  if (conform_band_due())
+    conform_band_update();
+  conform_band_state.moved += conform_band_state.step;
+  conform_band_state.steps++;
+
+  foreach() {
+    if (conform_band[] > 0.)
+      log_conform_psi_step (point);
+    else {
+      Psi11[] = Psi12[] = Psi22[] = 0.;
+#if AXI
+      Psiqq[] = 0.;
+#endif
+    }
+  }
+#else
+  foreach()
+    log_conform_psi_step (point);
+#endif
+
+#if AXI
+  advection ({Psi11, Psi12, Psi22, Psiqq}, uf, dt);
+#else
+  advection ({Psi11, Psi12, Psi22}, uf, dt);
+#endif
+
+  foreach() {
+    double intFactor = log_conform_int_factor (conform_lambda(), dt);
+
+    double a11 = 1., a12 = 0., a22 = 1.;
+    if (intFactor > 0.) {
+      pseudo_t Psi = {{Psi11[], Psi12[]}, {Psi12[], Psi22[]}}, R;
+      pseudo_v Lambda;
+      diagonalization_2D_nobranch (&Lambda, &R, &Psi);
+
+      pseudo_v eL = {intFactor*exp(Lambda.x), intFactor*exp(Lambda.y)};
+      a12 = R.x.x*R.y.x*eL.x + R.y.y*R.x.y*eL.y;
+      a11 = (1. - intFactor) + sq(R.x.x)*eL.x + sq(R.x.y)*eL.y;
+      a22 = (1. - intFactor) + sq(R.y.y)*eL.y + sq(R.y.x)*eL.x;
+    }
+
+#if AXI
+    double Aqq = intFactor > 0. ? (1. - intFactor) + intFactor*exp(Psiqq[]) : 1.;
+    AThTh[] = Aqq;
+#endif
+    A12[] = a12;
+    A11[] = a11;
+    A22[] = a22;
+
+#if !LEAN_FIELDS
+#if AXI
+    T_ThTh[] = Gp[]*(Aqq - 1.);
+#endif
+    T12[] = Gp[]*a12;
+    T11[] = Gp[]*(a11 - 1.);
+    T22[] = Gp[]*(a22 - 1.);
+#endif
+  }
+}
+
+/**
+### Event: tracer_advection
+
+`FUSED_LOG_CONFORM` selects the kernel at compile time
+(`qcc -DFUSED_LOG_CONFORM=1 ...`). The reference kernel is the default.
+Nothing is done in the Newtonian regime. */
+
+#ifndef FUSED_LOG_CONFORM
+# define FUSED_LOG_CONFORM 0
+#endif
+#if CONFORM_BAND && !FUSED_LOG_CONFORM
+# undef FUSED_LOG_CONFORM
+# define FUSED_LOG_CONFORM 1
+#endif
+
+event tracer_advection(i++)
+{
+  if (log_conform_regime != LOG_CONFORM_NEWTONIAN) {
+#if FUSED_LOG_CONFORM
+    log_conform_fused();
+#else
+    log_conform_reference();
+#endif
   }
 }
 
@@ -538,19 +1073,25 @@ calculated directly from center values of cells sharing the face. The
 other one is harder. It will be computed from vertex values. The
 vertex values are obtained by averaging centered values.  Note that as
 a result of the vertex averaging cells `[]` and `[-1,0]` are not
-involved in the computation of shear. */
+involved in the computation of shear.
+
+The polymeric stress vanishes in the Newtonian regime and the event
+returns without touching `a`. */
 
 event acceleration (i++)
 {
+  if (log_conform_regime == LOG_CONFORM_NEWTONIAN)
+    return 0;
+
   face vector av = a;
 
   foreach_face(x){
     if (fm.x[] > 1e-20) {
 
-      double shearX = (T12[0,1]*cm[0,1] + T12[-1,1]*cm[-1,1] -
-      T12[0,-1]*cm[0,-1] - T12[-1,-1]*cm[-1,-1])/4.;
+      double shearX = (conform_T12(0,1)*cm[0,1] + conform_T12(-1,1)*cm[-1,1] -
+      conform_T12(0,-1)*cm[0,-1] - conform_T12(-1,-1)*cm[-1,-1])/4.;
 
-      av.x[] += (shearX + cm[]*T11[] - cm[-1]*T11[-1])*
+      av.x[] += (shearX + cm[]*conform_T11(0,0) - cm[-1]*conform_T11(-1,0))*
       alpha.x[]/(sq(fm.x[])*Delta);
 
     }
@@ -559,10 +1100,10 @@ event acceleration (i++)
   foreach_face(y){
     if (fm.y[] > 1e-20) {
 
-      double shearY = (T12[1,0]*cm[1,0] + T12[1,-1]*cm[1,-1] -
-      T12[-1,0]*cm[-1,0] - T12[-1,-1]*cm[-1,-1])/4.;
+      double shearY = (conform_T12(1,0)*cm[1,0] + conform_T12(1,-1)*cm[1,-1] -
+      conform_T12(-1,0)*cm[-1,0] - conform_T12(-1,-1)*cm[-1,-1])/4.;
 
-      av.y[] += (shearY + cm[]*T22[] - cm[0,-1]*T22[0,-1])*
+      av.y[] += (shearY + cm[]*conform_T22(0,0) - cm[0,-1]*conform_T22(0,-1))*
       alpha.y[]/(sq(fm.y[])*Delta);
 
     }
@@ -571,6 +1112,6 @@ event acceleration (i++)
 #if AXI
   foreach_face(y)
     if (y > 1e-20)
-      av.y[] -= (T_ThTh[] + T_ThTh[0,-1])*alpha.y[]/sq(y)/2.;
+      av.y[] -= (conform_TThTh(0,0) + conform_TThTh(0,-1))*alpha.y[]/sq(y)/2.;
 #endif
 }
@@ -20,6 +20,8 @@ the provided default is returned.
 - `params_init_from_argv()`: Initialize runtime key/value storage.
 - `param_string()`: Access raw string values.
 - `param_int()`, `param_double()`, `param_bool()`: Typed accessors with defaults.
+- `params_case_count()`, `params_select_case()`: Iterate over the cases of
+  an ensemble file (see `parse_params.h`).
 */
 
 #ifndef PARAMS_H
@@ -67,6 +69,31 @@ static inline void params_init_from_argv (int argc, const char * argv[])
   parse_params_init_from_argv(argc, argv);
 }
 
+/**
+### params_case_count()
+
+#### Returns
+- Number of `[case]` blocks in the parameter file (`0`: single case).
+*/
+static inline int params_case_count (void)
+{
+  return parse_params_case_count();
+}
+
+/**
+### params_select_case()
+
+Makes case block `index` (0-based) the active parameter set; the typed
+accessors below then read its values.
+
+#### Returns
+- `0` on success, `-1` when the block does not exist.
+*/
+static inline int params_select_case (int index)
+{
+  return parse_params_select_case(index);
+}
+
 /**
 ### param_string()
 
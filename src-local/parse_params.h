@@ -6,7 +6,27 @@ Low-level key/value parameter storage and loader used by `params.h`.
 This header manages:
 - loading `key=value` parameter files,
 - storing parsed entries in an internal map,
-- retrieving raw string values.
+- retrieving raw string values,
+- selecting one case of a multi-case (ensemble) file.
+
+## Ensemble Files
+
+A line `[case]` starts a case block. Keys before the first block are
+shared by every case; keys inside a block override them for that case
+only:
+
+```
+MAXlevel=9
+tmax=5
+[case]
+CaseNo=1000
+De=1
+[case]
+CaseNo=1001
+De=10
+```
+
+A file without `[case]` lines is a single case, as before.
 
 Type conversion (`int`, `double`, `bool`) is intentionally handled in
 `params.h`.
@@ -15,6 +35,8 @@ Type conversion (`int`, `double`, `bool`) is intentionally handled in
 
 - `parse_params_init_from_argv()`: Pick parameter file from CLI and load it.
 - `parse_param_string()`: Read raw string values with a default fallback.
+- `parse_params_case_count()`: Number of `[case]` blocks of the file.
+- `parse_params_select_case()`: Load the shared keys plus one case block.
 */
 
 #ifndef PARSE_PARAMS_H
@@ -120,20 +142,33 @@ static inline void parse_params_set_value (const char * key,
 }
 
 /**
-### parse_params_load()
+### parse_params_is_case_marker()
+
+#### Returns
+- `true` when the (comment-stripped) line is a `[case]` block marker.
+*/
+static inline bool parse_params_is_case_marker (char * line)
+{
+  return !strcmp(parse_params_trim(line), "[case]");
+}
+
+/**
+### parse_params_load_case()
 
 Loads parameters from `filename`.
 
 Parsing rules:
 - comments begin with `#`,
 - each valid line is `key=value`,
-- malformed lines without `=` are ignored.
+- malformed lines without `=` are ignored,
+- with `index >= 0`, only the shared keys and those of the case block
+  `index` (0-based) are kept; `index < 0` keeps every line.
 
 #### Returns
 - `0` on successful load,
-- `-1` when the file is not found.
+- `-1` when the file is not found or has no block `index`.
 */
-static inline int parse_params_load (const char * filename)
+static inline int parse_params_load_case (const char * filename, int index)
 {
   _parse_params_count = 0;
   _parse_params_loaded = true;
@@ -149,6 +184,7 @@ static inline int parse_params_load (const char * filename)
     return -1;
   }
 
+  int block = -1;
   char line[PARSE_PARAMS_KEY_LEN + PARSE_PARAMS_VALUE_LEN + 64];
   while (fgets(line, sizeof(line), fp)) {
     char * comment = strchr(line, '#');
@@ -156,7 +192,12 @@ static inline int parse_params_load (const char * filename)
       *comment = '\0';
 
     char * eq = strchr(line, '=');
-    if (!eq)
+    if (!eq) {
+      if (parse_params_is_case_marker(line))
+        block++;
+      continue;
+    }
+    if (index >= 0 && block >= 0 && block != index)
       continue;
 
     *eq = '\0';
@@ -169,7 +210,17 @@ static inline int parse_params_load (const char * filename)
   }
 
   fclose(fp);
-  return 0;
+  return index < 0 || index <= block ? 0 : -1;
+}
+
+/**
+### parse_params_load()
+
+Loads every `key=value` line of `filename` (see `parse_params_load_case()`).
+*/
+static inline int parse_params_load (const char * filename)
+{
+  return parse_params_load_case(filename, -1);
 }
 
 /**
@@ -228,4 +279,45 @@ static inline const char * parse_param_string (const char * key,
   return idx >= 0 ? _parse_params_entries[idx].value : default_value;
 }
 
+/**
+### parse_params_case_count()
+
+#### Returns
+- The number of `[case]` blocks in the current parameter file, `0` for a
+  single-case file or a missing file.
+*/
+static inline int parse_params_case_count (void)
+{
+  FILE * fp = fopen(_parse_params_file, "r");
+  if (!fp)
+    return 0;
+
+  int count = 0;
+  char line[PARSE_PARAMS_KEY_LEN + PARSE_PARAMS_VALUE_LEN + 64];
+  while (fgets(line, sizeof(line), fp)) {
+    char * comment = strchr(line, '#');
+    if (comment)
+      *comment = '\0';
+    if (!strchr(line, '=') && parse_params_is_case_marker(line))
+      count++;
+  }
+
+  fclose(fp);
+  return count;
+}
+
+/**
+### parse_params_select_case()
+
+Replaces the stored entries by the shared keys and the keys of case block
+`index` of the current parameter file.
+
+#### Returns
+- `0` on success, `-1` when the block does not exist.
+*/
+static inline int parse_params_select_case (int index)
+{
+  return parse_params_load_case(_parse_params_file, index);
+}
+
 #endif
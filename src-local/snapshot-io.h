@@ -0,0 +1,531 @@
+/**
+# snapshot-io.h
+
+Lean snapshot writing and transparent restore of compressed snapshots.
+
+Near pinch-off the cases write a snapshot every `1e-4` time units. A full
+`dump()` also serializes fields that are rebuilt from the primitive state
+at the next step (the polymeric stresses `T11`, `T12`, `T22`, `T_ThTh`,
+the filtered `sf`, the material property fields, `KAPPA`, `Y`, ...).
+
+- `snapshot_write()` dumps only the listed fields and can replace the
+  file by a losslessly compressed copy.
+- `snapshot_restore()` reads plain, `.gz` or `.zst` snapshots, so the
+  post-processing helpers accept either.
+
+Restart files are not compressed. They are written with the full field
+list by the caller, at its own cadence.
+
+Precision stays at `float64` and values are stored as is, without delta
+encoding, because Basilisk's `dump()`/`restore()` format only stores
+doubles in tree order; a snapshot written otherwise could not be restored
+by `restore()` or the post-processing helpers. Size reduction comes from
+the field subset and from compression.
+
+## Asynchronous Writing
+
+`snapshot_write_async()` serializes the fields into a memory buffer with
+`dump(fp = open_memstream(...))`; this is the only part the time loop
+waits for. A background thread then writes the buffer to a temporary
+`name~`, renames it into place and compresses it, one snapshot at a
+time, so at most one compressor runs per process. Because of the renames
+(here and in `snapshot_compress()`), a reader never sees a partial file.
+
+- Memory is capped by a bounded queue of `snapshot_async_depth` pending
+  buffers (at most `SNAPSHOT_ASYNC_MAX`). When the queue is full, the
+  solver blocks until the writer frees a slot.
+- Jobs are written in submission order. `snapshot_async_drain()` waits
+  for the queue to empty. Call it before any synchronous `dump()` of a
+  file that may also be queued (e.g. `restart`), so an older queued copy
+  cannot replace a newer one.
+- Under MPI, `dump()` writes the shared file collectively, so
+  `snapshot_write_async()` falls back to `snapshot_write()` and
+  `snapshot_async_available()` returns `false`; callers warn once at
+  startup rather than let the option silently do nothing.
+- Builds on glibc older than 2.34 may need `-lpthread`.
+
+## Snapshot Index
+
+`snapshot_index_row()` prepares one text row per snapshot for an index
+file (the cases use `intermediate/snapshots.index`), so post-processing can
+select snapshots without listing, statting or opening them:
+
+```
+# file t i bytes hm maxlevel
+intermediate/snapshot-0.050000.zst 0.050000000000000003 5000 123456 0.95 9
+```
+
+- `file`: final path, with the `.gz`/`.zst` suffix when compressed (a
+  snapshot whose compression failed is listed uncompressed);
+- `t`: exact time (`%.17g`), `i`: iteration;
+- `bytes`: size of the uncompressed dump;
+- `hm`: minimum neck radius, `maxlevel`: deepest leaf level.
+
+The index is append-only. After a restart, the rows of the rewritten
+snapshots appear again; readers keep the last row per file. The writer
+(`snapshot_write()` or the background thread) appends the row only once
+the file is complete, renamed and compressed, so every listed file exists
+under the listed name. A snapshot that could not be written is not
+listed.
+
+## Public API
+
+- `snapshot_compression()`: Parses a compressor name.
+- `snapshot_write()`: Dumps a field list and optionally compresses it.
+- `snapshot_restore()`: Restores a plain or compressed snapshot.
+- `snapshot_write_async()`: Same as `snapshot_write()`, with the file
+  I/O done by a background thread.
+- `snapshot_async_drain()`: Waits until every queued snapshot is on disk.
+- `snapshot_async_available()`: Whether this build writes in the
+  background (`false` under MPI).
+- `snapshot_index_row()`: Prepares the index row of a snapshot, for the
+  writers to append once the file is final.
+- `snapshot_index_find()`: Looks up the latest snapshot at or before a
+  given time in an index file.
+
+## Change Log
+
+- 2026-10-14: Initial primitive/compressed snapshot support.
+- 2026-10-14: Background writer thread with a bounded queue.
+- 2026-10-14: Writers return the dump size; append-only snapshot index.
+- 2026-10-14: Index lookup by time (warm starts from another case).
+- 2026-10-14: Atomic dumps; compression in the writing thread, into a
+  temporary file, with its exit status checked.
+- 2026-10-14: Index rows are appended by the writer once the file is final.
+- 2026-10-14: A missing compressor is reported once and disabled.
+- 2026-10-14: `snapshot_async_available()`, for the MPI warning.
+*/
+
+#ifndef SNAPSHOT_IO_H
+#define SNAPSHOT_IO_H
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+enum {
+  SNAPSHOT_PLAIN = 0,
+  SNAPSHOT_GZIP,
+  SNAPSHOT_ZSTD
+};
+
+/**
+### snapshot_compression()
+
+#### Returns
+- `SNAPSHOT_PLAIN`, `SNAPSHOT_GZIP` or `SNAPSHOT_ZSTD` for `"none"`,
+  `"gzip"` and `"zstd"`, or `-1` for an unknown name.
+*/
+static int snapshot_compression (const char * name)
+{
+  if (!name || !strcmp (name, "none"))
+    return SNAPSHOT_PLAIN;
+  if (!strcmp (name, "gzip"))
+    return SNAPSHOT_GZIP;
+  if (!strcmp (name, "zstd"))
+    return SNAPSHOT_ZSTD;
+  return -1;
+}
+
+/**
+### snapshot_compress()
+
+Replaces `name` by `name.gz` or `name.zst`. The compressor writes a
+temporary `name.gz~` (`name.zst~`), which is renamed into place only once
+the compressor has exited successfully; `name` is removed after that. On
+any failure the temporary file is removed and `name` is kept as is, so a
+reader only ever sees a complete snapshot under either name. When the
+shell cannot find the compressor (exit status `127`), a single warning is
+printed and that compressor is not tried again in this process: the
+following snapshots stay uncompressed.
+
+Runs in the calling thread: `snapshot_write()` waits for it, the
+background writer compresses in its own thread (see below).
+
+#### Returns
+- `true` if `name` was replaced by its compressed copy, `false` without
+  compression or if compression failed (with a warning).
+*/
+static bool snapshot_compress (const char * name, int compression)
+{
+  static bool missing[SNAPSHOT_ZSTD + 1];
+  if (compression == SNAPSHOT_PLAIN || missing[compression])
+    return false;
+
+  const char * suffix = compression == SNAPSHOT_GZIP ? ".gz" : ".zst";
+  char packed[260], tmp[264], cmd[1024];
+  snprintf (packed, sizeof(packed), "%s%s", name, suffix);
+  snprintf (tmp, sizeof(tmp), "%s~", packed);
+  if (compression == SNAPSHOT_GZIP)
+    snprintf (cmd, sizeof(cmd), "gzip -c -1 '%s' > '%s' 2> /dev/null",
+              name, tmp);
+  else
+    snprintf (cmd, sizeof(cmd), "zstd -q -f -T1 '%s' -o '%s' 2> /dev/null",
+              name, tmp);
+
+  int status = system (cmd);
+  if (status != -1 && WIFEXITED (status) && WEXITSTATUS (status) == 127) {
+    remove (tmp);
+    missing[compression] = true;
+    fprintf (ferr, "WARNING: %s not found, keeping snapshots uncompressed\n",
+             compression == SNAPSHOT_GZIP ? "gzip" : "zstd");
+    return false;
+  }
+  if (status == -1 || !WIFEXITED (status) || WEXITSTATUS (status) != 0 ||
+      rename (tmp, packed)) {
+    remove (tmp);
+    fprintf (ferr, "WARNING: could not compress %s (status %d),"
+             " keeping it uncompressed\n", name, status);
+    return false;
+  }
+  remove (name);
+  return true;
+}
+
+/**
+## Index
+
+### snapshot_index_row()
+
+Prepares the row of a snapshot for `index` (see Snapshot Index) at the
+current `t` and `iter`. Must be called on every rank: the deepest level is a
+reduction. The row is appended by the writer once the snapshot is final.
+*/
+
+typedef struct {
+  char index[256];  // index file
+  double t, hm;
+  int i, maxlevel;
+} SnapshotRow;
+
+static SnapshotRow snapshot_index_row (const char * index, double hm)
+{
+  SnapshotRow row = {.t = t, .hm = hm, .i = iter};
+  snprintf (row.index, sizeof(row.index), "%s", index);
+  int maxlevel = 0;
+  foreach (reduction(max:maxlevel))
+    if (level > maxlevel)
+      maxlevel = level;
+  row.maxlevel = maxlevel;
+  return row;
+}
+
+/**
+### snapshot_index_append()
+
+Appends `row` for the final file `name` (with its `.gz`/`.zst` suffix if
+compressed) and the uncompressed size `bytes`. Called on rank 0 only,
+after the file is in place.
+*/
+static void snapshot_index_append (const SnapshotRow * row, const char * name,
+                                   long bytes)
+{
+  FILE * fp = fopen (row->index, "a");
+  if (!fp) {
+    fprintf (ferr, "WARNING: cannot append to snapshot index %s\n",
+             row->index);
+    return;
+  }
+  fseek (fp, 0, SEEK_END);
+  if (ftell (fp) == 0)
+    fputs ("# file t i bytes hm maxlevel\n", fp);
+  fprintf (fp, "%s %.17g %d %ld %.10g %d\n", name, row->t, row->i, bytes,
+           row->hm, row->maxlevel);
+  fclose (fp);
+}
+
+/**
+### snapshot_finish()
+
+Compresses the complete file `name` if requested and appends its index
+row, with the name it ends up under. */
+
+static void snapshot_finish (const char * name, int compression,
+                             const SnapshotRow * row, long bytes)
+{
+  bool packed = snapshot_compress (name, compression);
+  if (!row)
+    return;
+  char file[270];
+  snprintf (file, sizeof(file), "%s%s", name, !packed ? "" :
+            compression == SNAPSHOT_GZIP ? ".gz" : ".zst");
+  snapshot_index_append (row, file, bytes);
+}
+
+/**
+## Writing
+
+### snapshot_write()
+
+Dumps `list` to a temporary `name~` and renames it to `name`, so no
+reader sees a partial dump. With compression, rank 0 then replaces the
+file by `name.gz` or `name.zst` (see `snapshot_compress()`); the time loop
+waits for the compressor, so use `snapshot_write_async()` to overlap it
+with the next steps. The index row `row` (from `snapshot_index_row()`,
+`NULL` for none) is appended last.
+
+#### Returns
+- The size of the uncompressed dump in bytes on rank 0, `-1` on the other
+  ranks or if it cannot be determined.
+*/
+static long snapshot_write (const char * name, scalar * list, int compression,
+                            const SnapshotRow * row)
+{
+  char tmp[260];
+  snprintf (tmp, sizeof(tmp), "%s~", name);
+  dump (file = tmp, list = list);
+#if _MPI
+  // Every rank has written its part before rank 0 publishes the file.
+  MPI_Barrier (MPI_COMM_WORLD);
+#endif
+
+  long bytes = -1;
+  if (pid() == 0) {
+    struct stat st;
+    if (!stat (tmp, &st))
+      bytes = st.st_size;
+    if (rename (tmp, name)) {
+      fprintf (ferr, "ERROR: cannot write snapshot %s\n", name);
+      return -1;
+    }
+    snapshot_finish (name, compression, row, bytes);
+  }
+  return bytes;
+}
+
+/**
+### snapshot_restore()
+
+Restores `name`. Files ending in `.gz` or `.zst` are decompressed through
+a pipe; everything else goes to `restore()` directly.
+
+#### Returns
+- `true` on success, `false` if the file cannot be opened.
+*/
+static bool snapshot_restore (const char * name, scalar * list)
+{
+  size_t n = strlen (name);
+  const char * tool = NULL;
+  if (n > 3 && !strcmp (name + n - 3, ".gz"))
+    tool = "gzip -dc";
+  else if (n > 4 && !strcmp (name + n - 4, ".zst"))
+    tool = "zstd -dcq";
+  if (!tool)
+    return restore (file = name, list = list);
+
+  FILE * check = fopen (name, "rb");
+  if (!check)
+    return false;
+  fclose (check);
+
+  char cmd[512];
+  snprintf (cmd, sizeof(cmd), "%s '%s'", tool, name);
+  FILE * fp = popen (cmd, "r");
+  if (!fp)
+    return false;
+  bool ok = restore (fp = fp, list = list);
+  return pclose (fp) == 0 && ok;
+}
+
+/**
+## Background Writer
+*/
+
+#ifndef SNAPSHOT_ASYNC_MAX
+# define SNAPSHOT_ASYNC_MAX 16
+#endif
+
+int snapshot_async_depth = 2;
+
+#if !_MPI
+#include <pthread.h>
+
+typedef struct {
+  char name[256];
+  char * data;
+  size_t size;
+  int compression;
+  bool indexed;     // append row once the file is final
+  SnapshotRow row;
+} SnapshotJob;
+
+static struct {
+  SnapshotJob jobs[SNAPSHOT_ASYNC_MAX];
+  int head, count;
+  bool busy, started;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+} snapshot_async = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .changed = PTHREAD_COND_INITIALIZER
+};
+
+/**
+### snapshot_async_writer()
+
+Thread body: writes queued buffers in order, forever. */
+
+static void * snapshot_async_writer (void * arg)
+{
+  for (;;) {
+    pthread_mutex_lock (&snapshot_async.lock);
+    while (!snapshot_async.count)
+      pthread_cond_wait (&snapshot_async.changed, &snapshot_async.lock);
+    SnapshotJob job = snapshot_async.jobs[snapshot_async.head];
+    snapshot_async.busy = true;
+    pthread_mutex_unlock (&snapshot_async.lock);
+
+    char tmp[260];
+    snprintf (tmp, sizeof(tmp), "%s~", job.name);
+    FILE * fp = fopen (tmp, "wb");
+    bool ok = fp && fwrite (job.data, 1, job.size, fp) == job.size;
+    if (fp && fclose (fp))
+      ok = false;
+    if (ok && !rename (tmp, job.name))
+      snapshot_finish (job.name, job.compression,
+                       job.indexed ? &job.row : NULL, job.size);
+    else
+      fprintf (ferr, "ERROR: cannot write snapshot %s\n", job.name);
+    free (job.data);
+
+    pthread_mutex_lock (&snapshot_async.lock);
+    snapshot_async.head = (snapshot_async.head + 1) % SNAPSHOT_ASYNC_MAX;
+    snapshot_async.count--;
+    snapshot_async.busy = false;
+    pthread_cond_broadcast (&snapshot_async.changed);
+    pthread_mutex_unlock (&snapshot_async.lock);
+  }
+  return arg;
+}
+
+/**
+### snapshot_write_async()
+
+Serializes `list` into memory and queues it for writing to `name`, then
+returns. Blocks only while the queue already holds
+`snapshot_async_depth` buffers.
+
+#### Returns
+- The size of the dump in bytes, as `snapshot_write()`.
+*/
+static long snapshot_write_async (const char * name, scalar * list,
+                                  int compression, const SnapshotRow * row)
+{
+  SnapshotJob job = {.compression = compression, .indexed = row != NULL};
+  snprintf (job.name, sizeof(job.name), "%s", name);
+  if (row)
+    job.row = *row;
+  FILE * fp = open_memstream (&job.data, &job.size);
+  if (!fp)
+    return snapshot_write (name, list, compression, row);
+  dump (fp = fp, list = list);
+  fclose (fp);
+  long bytes = job.size;
+
+  int depth = clamp (snapshot_async_depth, 1, SNAPSHOT_ASYNC_MAX);
+  pthread_mutex_lock (&snapshot_async.lock);
+  if (!snapshot_async.started) {
+    if (pthread_create (&snapshot_async.thread, NULL,
+                        snapshot_async_writer, NULL)) {
+      pthread_mutex_unlock (&snapshot_async.lock);
+      free (job.data);
+      return snapshot_write (name, list, compression, row);
+    }
+    pthread_detach (snapshot_async.thread);
+    snapshot_async.started = true;
+  }
+  while (snapshot_async.count >= depth)
+    pthread_cond_wait (&snapshot_async.changed, &snapshot_async.lock);
+  int tail = (snapshot_async.head + snapshot_async.count) % SNAPSHOT_ASYNC_MAX;
+  snapshot_async.jobs[tail] = job;
+  snapshot_async.count++;
+  pthread_cond_broadcast (&snapshot_async.changed);
+  pthread_mutex_unlock (&snapshot_async.lock);
+  return bytes;
+}
+
+/**
+### snapshot_async_drain()
+
+Waits until the writer has finished every queued snapshot. */
+
+static void snapshot_async_drain (void)
+{
+  pthread_mutex_lock (&snapshot_async.lock);
+  while (snapshot_async.count || snapshot_async.busy)
+    pthread_cond_wait (&snapshot_async.changed, &snapshot_async.lock);
+  pthread_mutex_unlock (&snapshot_async.lock);
+}
+
+#else // _MPI
+
+static long snapshot_write_async (const char * name, scalar * list,
+                                  int compression, const SnapshotRow * row)
+{
+  return snapshot_write (name, list, compression, row);
+}
+
+static void snapshot_async_drain (void) {}
+
+#endif // _MPI
+
+static inline bool snapshot_async_available (void)
+{
+#if _MPI
+  return false;
+#else
+  return true;
+#endif
+}
+
+/**
+## Index Lookup
+
+### snapshot_index_find()
+
+Finds, in `index`, the snapshot with the largest time not after `time`
+(within a relative `1e-9`, so a time printed with six decimals matches its
+snapshot). A file listed twice keeps its last row.
+
+#### Returns
+- The time of the snapshot, with its path (as listed) in `name`, or `-1`
+  if the index cannot be read or lists no snapshot before `time`.
+*/
+static double snapshot_index_find (const char * index, double time,
+                                   char * name, size_t size)
+{
+  FILE * fp = fopen (index, "r");
+  if (!fp)
+    return -1.;
+
+  char line[512], file[256];
+  double best = -1., ts, hm;
+  int it, level;
+  long bytes;
+  while (fgets (line, sizeof(line), fp)) {
+    if (line[0] == '#' ||
+        sscanf (line, "%255s %lf %d %ld %lf %d", file, &ts, &it, &bytes, &hm,
+                &level) != 6)
+      continue;
+    if (ts <= time + 1e-9*fabs(time) && ts >= best) {
+      best = ts;
+      snprintf (name, size, "%s", file);
+    }
+  }
+  fclose (fp);
+  return best;
+}
+
+/**
+## Event: snapshot_async_end
+
+Queued snapshots are on disk before the program exits. */
+
+event snapshot_async_end (t = end)
+{
+  snapshot_async_drain();
+}
+
+#endif
@@ -0,0 +1,261 @@
+/**
+# solver-control.h
+
+Multigrid telemetry, neck-dependent `TOLERANCE` and an extrapolated
+pressure guess for the simulation cases.
+
+## Telemetry
+
+After every step, the statistics of the three multigrid solves of
+`navier-stokes/centered.h` are appended to a CSV file (rank 0, buffered,
+flushed every `SOLVER_LOG_FLUSH` rows and at the end of the run):
+
+`i,t,dt,tolerance,hm,mgp_i,mgp_resb,mgp_resa,mgpf_i,mgpf_resa,mgu_i,mgu_resa`
+
+- `mgp`: pressure projection; `mgpf`: approximate projection of the face
+  velocity (not run with `stokes = true`, so its columns stay `0`);
+  `mgu`: viscous solve;
+- `_i`: V-cycles, `_resb`/`_resa`: maximum residual before/after the
+  solve;
+- `tolerance`: the `TOLERANCE` of the step, `hm`: the neck radius.
+
+The solves start from the previous step's pressure and velocity
+(Basilisk's own warm start), or from the extrapolated pressure below, so
+the iteration counts measure how far the guess is from the solution.
+
+## Extrapolated Pressure Guess
+
+With `solver_control.extrapolate`, the projection starts from the
+pressure extrapolated linearly from the last two steps,
+
+$$
+p^{guess} = p^n + r\,(p^n - p^{n-1}),\qquad
+r = \min\left(\Delta t^{n+1}/\Delta t^n,\, 2ight),
+$$
+
+instead of $p^n$. The ratio is capped because a step shortened to land on
+an event time makes $p^n - p^{n-1}$ a poor slope for the next, longer
+step. The previous pressure is kept in a field that is not dumped, so the
+first step after a restart starts from $p^n$ alone. The `mgp_i` column of
+the telemetry compares the two guesses on the same case.
+
+The viscous solve needs no separate guess: `viscosity()` starts from the
+predicted velocity of the step itself, already one step ahead of $u^n$.
+
+## Adaptive Tolerance
+
+With `solver_control.adaptive`, `TOLERANCE` follows the neck radius
+`h_min` instead of staying fixed:
+
+$$
+\mathrm{TOLERANCE} = \min\left(t_{max},\,
+  \max\left(t_{min},\, t_{max}\,h_{min}/h_{ref}\right)\right)
+$$
+
+loose (`t_max`) while `h_min >= h_ref` (the smooth early phase) and one
+decade tighter per decade of thinning, down to `t_min` near pinch-off.
+It is set at the end of each step for the solves of the next one.
+
+If a solve needs more than `solver_control.iter_max` cycles, or stops at
+`NITERMAX` without reaching the tolerance, the policy falls back to the
+fixed `solver_control.fixed` tolerance for the rest of the case, and says
+so in the log.
+
+## Requirements
+
+Include after `navier-stokes/centered.h`, `diagnostics-log.h` and
+`interface-geometry.h`.
+
+## Public API
+
+- `solver_control_setup()`: Sets the fixed tolerance and the adaptive
+  policy, and applies the first `TOLERANCE`.
+- `solver_control_open()`: Opens the CSV telemetry file.
+- `solver_control_extrapolate()`: Enables the extrapolated pressure guess.
+
+## Change Log
+
+- 2026-10-14: Initial telemetry and neck-dependent tolerance.
+- 2026-10-14: Optional extrapolated pressure guess for the projection.
+*/
+
+#ifndef SOLVER_CONTROL_H
+#define SOLVER_CONTROL_H
+
+#ifndef SOLVER_LOG_FLUSH
+# define SOLVER_LOG_FLUSH 100
+#endif
+
+static struct {
+  double fixed;        // tolerance without (or after falling back from) the policy
+  bool adaptive;       // neck-dependent tolerance
+  bool fallen_back;    // the policy was abandoned for this case
+  double tol_max, tol_min, neck;
+  int iter_max;        // cycles per solve before falling back
+  bool extrapolate;    // extrapolated pressure guess
+  bool have_prev;      // p_prev holds the pressure of the previous step
+  scalar p_prev;
+  double dt_prev;
+  FILE * fp;
+  int rows;
+} solver_control = {.fixed = 1e-4, .iter_max = 50};
+
+/**
+### solver_control_setup()
+
+#### Parameters
+- `fixed`: `TOLERANCE` without the policy, and after a fallback.
+- `adaptive`: Use the neck-dependent policy.
+- `tol_max`, `tol_min`: Loosest and tightest tolerance of the policy.
+- `neck`: Neck radius `h_ref` below which the tolerance tightens.
+- `iter_max`: Cycles of a single solve that trigger the fallback.
+*/
+static void solver_control_setup (double fixed, bool adaptive, double tol_max,
+                                  double tol_min, double neck, int iter_max)
+{
+  solver_control.fixed = fixed;
+  solver_control.adaptive = adaptive;
+  solver_control.fallen_back = false;
+  solver_control.tol_max = tol_max;
+  solver_control.tol_min = tol_min;
+  solver_control.neck = neck;
+  solver_control.iter_max = iter_max;
+  TOLERANCE = adaptive ? tol_max : fixed;
+}
+
+/**
+### solver_control_open()
+
+#### Parameters
+- `path`: CSV telemetry file.
+- `fresh`: Truncate `path` and write the header; otherwise append (after
+  a restart).
+*/
+static void solver_control_open (const char * path, bool fresh)
+{
+  if (pid() != 0 || solver_control.fp)
+    return;
+  solver_control.fp = fopen (path, fresh ? "w" : "a");
+  if (!solver_control.fp) {
+    fprintf (ferr, "WARNING: cannot write solver log %s\n", path);
+    return;
+  }
+  if (fresh)
+    fputs ("i,t,dt,tolerance,hm,mgp_i,mgp_resb,mgp_resa,mgpf_i,mgpf_resa,"
+           "mgu_i,mgu_resa\n", solver_control.fp);
+  solver_control.rows = 0;
+}
+
+/**
+### solver_control_extrapolate()
+
+Enables or disables the extrapolated pressure guess for the current case.
+The field of the previous pressure is allocated at the first projection.
+*/
+static void solver_control_extrapolate (bool extrapolate)
+{
+  solver_control.extrapolate = extrapolate;
+  solver_control.dt_prev = 0.;
+}
+
+/**
+## Event: projection
+
+Runs just before the projection of `navier-stokes/centered.h` (Basilisk
+runs the latest definition of an event name first) and replaces `p` by
+the extrapolated guess, keeping $p^n$ for the next step. */
+
+event projection (i++)
+{
+  if (!solver_control.extrapolate)
+    return 0;
+
+  if (!solver_control.have_prev) {
+    solver_control.p_prev = new scalar;
+    solver_control.p_prev.nodump = true;
+    solver_control.have_prev = true;
+    solver_control.dt_prev = 0.;
+  }
+
+  scalar pp = solver_control.p_prev;
+  if (solver_control.dt_prev > 0.) {
+    double r = min (dt/solver_control.dt_prev, 2.);
+    foreach() {
+      double pn = p[];
+      p[] += r*(pn - pp[]);
+      pp[] = pn;
+    }
+  }
+  else
+    foreach()
+      pp[] = p[];
+  solver_control.dt_prev = dt;
+}
+
+/**
+### solver_control_converged()
+
+#### Returns
+- `false` if the solve described by `s` took more than `iter_max` cycles,
+  or ran out of cycles above the tolerance.
+*/
+static bool solver_control_converged (mgstats s)
+{
+  return s.i <= solver_control.iter_max &&
+    !(s.i >= NITERMAX && s.resa > TOLERANCE);
+}
+
+/**
+## Event: solver_control
+
+Records the solves of the step, checks them, and sets `TOLERANCE` for the
+next step. */
+
+event solver_control (i++)
+{
+  double hm = interface_geometry()->y_min;
+
+  if (solver_control.fp) {
+    fprintf (solver_control.fp, "%d,%g,%g,%g,%g,%d,%g,%g,%d,%g,%d,%g\n",
+             i, t, dt, TOLERANCE, hm, mgp.i, mgp.resb, mgp.resa,
+             mgpf.i, mgpf.resa, mgu.i, mgu.resa);
+    if (++solver_control.rows % SOLVER_LOG_FLUSH == 0)
+      fflush (solver_control.fp);
+  }
+
+  if (!solver_control.adaptive || solver_control.fallen_back)
+    return 0;
+
+  if (!solver_control_converged (mgp) || !solver_control_converged (mgpf) ||
+      !solver_control_converged (mgu)) {
+    solver_control.fallen_back = true;
+    TOLERANCE = solver_control.fixed;
+    diag_log_message ("Adaptive tolerance abandoned at i = %d, t = %g"
+                      " (cycles: projection %d, viscous %d); TOLERANCE %g",
+                      i, t, mgp.i, mgu.i, TOLERANCE);
+    return 0;
+  }
+
+  double tol = solver_control.tol_max*hm/solver_control.neck;
+  TOLERANCE = min (solver_control.tol_max, max (solver_control.tol_min, tol));
+}
+
+/**
+## Event: solver_control_end
+
+Closes the telemetry file and frees the previous pressure, so a
+following case of an ensemble starts afresh. */
+
+event solver_control_end (t = end)
+{
+  if (solver_control.fp) {
+    fclose (solver_control.fp);
+    solver_control.fp = NULL;
+  }
+  if (solver_control.have_prev) {
+    delete ({solver_control.p_prev});
+    solver_control.have_prev = false;
+  }
+}
+
+#endif
@@ -7,6 +7,8 @@ support viscoelastic flows with log-conformation rheology.
 ## Change Log
 
 - 2024-10-17: Add support for VE simulations.
+- 2026-10-14: Select the log-conformation regime from phase properties.
+- 2026-10-14: `LEAN_FIELDS`: modulus and relaxation time from `sf`, not stored.
 
 ## Two-Phase Interfacial Flows
 
@@ -40,8 +42,10 @@ cell-centered density.
 
 face vector alphav[];
 scalar rhov[];
+#if !LEAN_FIELDS
 scalar Gpd[];
 scalar lambdapd[];
+#endif
 
 /**
 ## Event: defaults
@@ -51,14 +55,35 @@ Registers custom face/cell property fields used by the centered solver.
 event defaults (i = 0) {
   alpha = alphav;
   rho = rhov;
+#if !LEAN_FIELDS
   Gp = Gpd;
   lambda = lambdapd;
+#endif
 
   /**
   If the viscosity is non-zero, we need to allocate the face-centered
   viscosity field. */
 
   mu = new face vector;
+
+  /**
+  Unless the case (or `LOG_CONFORM_REGIME`) fixed it, the log-conformation
+  regime follows from the phase properties: no elastic phase means no
+  conformation solve, and elastic phases that all have $\lambda \geq
+  10^{30}$ use the relaxation-free kernel. */
+
+#ifndef LOG_CONFORM_REGIME
+  if (log_conform_regime == LOG_CONFORM_AUTO) {
+    bool elastic1 = G1 != 0. && lambda1 != 0.;
+    bool elastic2 = G2 != 0. && lambda2 != 0.;
+    if (!elastic1 && !elastic2)
+      log_conform_regime = LOG_CONFORM_NEWTONIAN;
+    else if ((!elastic1 || lambda1 >= 1e30) && (!elastic2 || lambda2 >= 1e30))
+      log_conform_regime = LOG_CONFORM_NO_RELAXATION;
+    else
+      log_conform_regime = LOG_CONFORM_FULL;
+  }
+#endif
 }
 
 /**
@@ -84,6 +109,38 @@ scalar sf[];
 # define sf f
 #endif
 
+/**
+## Elastic Properties
+
+`conform_modulus()` and `conform_relaxation()` give $G_p$ and $\lambda$
+for a phase value `phase` (`sf`): each phase contributes in proportion to
+its fraction, where that fraction exceeds `TOLelastic`. The `properties`
+event stores them in `Gpd` and `lambdapd`; with `LEAN_FIELDS` the
+log-conformation kernels call them directly (see
+[log-conform-viscoelastic-scalar-2D.h](log-conform-viscoelastic-scalar-2D.h)).
+*/
+static double conform_modulus (double phase)
+{
+  double c = clamp (phase, 0., 1.);
+  return (c > TOLelastic ? G1*c : 0.) + (1. - c > TOLelastic ? G2*(1. - c) : 0.);
+}
+
+static double conform_relaxation (double phase)
+{
+  double c = clamp (phase, 0., 1.);
+  return ((c > TOLelastic ? lambda1*c : 0.) +
+          (1. - c > TOLelastic ? lambda2*(1. - c) : 0.));
+}
+
+#if LEAN_FIELDS
+event defaults (i = 0) {
+  conform_phase = sf;
+#ifndef sf
+  sf.nodump = true; // rebuilt from f at every step
+#endif
+}
+#endif
+
 /**
 ## Event: tracer_advection
 
@@ -137,18 +194,10 @@ event properties (i++) {
 
   foreach(){
     rhov[] = cm[]*rho(sf[]);
-
-    Gpd[] = 0.;
-    lambdapd[] = 0.;
-
-    if (clamp(sf[], 0., 1.) > TOLelastic){
-      Gpd[] += G1*clamp(sf[], 0., 1.);
-      lambdapd[] += lambda1*clamp(sf[], 0., 1.);
-    }
-    if (clamp((1-sf[]), 0., 1.) > TOLelastic){
-      Gpd[] += G2*clamp((1-sf[]), 0., 1.);
-      lambdapd[] += lambda2*clamp((1-sf[]), 0., 1.);
-    }
+#if !LEAN_FIELDS
+    Gpd[] = conform_modulus (sf[]);
+    lambdapd[] = conform_relaxation (sf[]);
+#endif
   }
 
 #if TREE
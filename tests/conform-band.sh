@@ -0,0 +1,86 @@
+#!/bin/bash
+# conform-band.sh
+#
+# Runs tests/conform-band.params twice with the fused log-conformation
+# kernel, once updating every cell (CONFORM_BAND=0) and once only in the
+# interface band (CONFORM_BAND=4), and checks that ke, hm and vm of the two
+# c<CaseNo>-log files agree row by row within a relative tolerance.
+#
+# Usage:
+#   bash tests/conform-band.sh [--mode in|out] [--tolerance REL]
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_DIR="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+MODE="in"
+TOLERANCE="1e-3"
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -h|--help)
+      sed -n '2,11p' "${BASH_SOURCE[0]}" | sed 's/^# \{0,1\}//'
+      exit 0
+      ;;
+    --mode) MODE="${2:-}"; shift 2 ;;
+    --mode=*) MODE="${1#*=}"; shift ;;
+    --tolerance) TOLERANCE="${2:-}"; shift 2 ;;
+    --tolerance=*) TOLERANCE="${1#*=}"; shift ;;
+    *) echo "ERROR: Unknown argument: $1" >&2; exit 1 ;;
+  esac
+done
+
+PARAM_FILE="${SCRIPT_DIR}/conform-band.params"
+LOG="${SCRIPT_DIR}/conform-band.log"
+TMP_DIR="$(mktemp -d)"
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+# run CASE_NO BAND: one case from t = 0 (a leftover restart would skip it).
+run() {
+  local case_no="$1" band="$2"
+  local params="${TMP_DIR}/c${case_no}.params"
+  { cat "$PARAM_FILE"; echo "CaseNo=${case_no}"; } > "$params"
+  rm -rf "${REPO_DIR}/simulationCases/c${case_no}-${MODE}"
+  if ! bash "${REPO_DIR}/runSimulation.sh" "$params" --mode "$MODE" \
+       --qcc-flags "-DFUSED_LOG_CONFORM=1 -DCONFORM_BAND=${band}" \
+       >> "$LOG" 2>&1; then
+    tail -n 20 "$LOG" >&2
+    echo "FAIL: case ${case_no} (CONFORM_BAND=${band}) failed" \
+         "(log: tests/conform-band.log)" >&2
+    exit 1
+  fi
+}
+
+: > "$LOG"
+run 9101 0
+run 9102 4
+
+FULL="${REPO_DIR}/simulationCases/c9101-${MODE}/c9101-log"
+BAND="${REPO_DIR}/simulationCases/c9102-${MODE}/c9102-log"
+
+# Rows are "i dt t ke hm vm"; the preamble and header lines are skipped.
+if ! awk -v tol="$TOLERANCE" '
+  function rel(a, b,   d, s) {
+    d = a - b; if (d < 0) d = -d
+    s = (a < 0 ? -a : a) + (b < 0 ? -b : b)
+    return s > 0 ? 2*d/s : 0
+  }
+  $1 !~ /^[0-9]+$/ { next }
+  NR == FNR { ke[$1] = $4; hm[$1] = $5; vm[$1] = $6; next }
+  ($1 in ke) {
+    rows++
+    e = rel(ke[$1], $4); if (rel(hm[$1], $5) > e) e = rel(hm[$1], $5)
+    if (rel(vm[$1], $6) > e) e = rel(vm[$1], $6)
+    if (e > worst) { worst = e; at = $1 }
+  }
+  END {
+    if (rows == 0) { print "FAIL: no common log rows" > "/dev/stderr"; exit 1 }
+    if (worst > tol) {
+      printf "FAIL: band differs from full update by %g at i = %d" \
+             " (tolerance %g)\n", worst, at, tol > "/dev/stderr"
+      exit 1
+    }
+    printf "PASS: %d rows, largest relative difference %g\n", rows, worst
+  }' "$FULL" "$BAND"; then
+  exit 1
+fi
@@ -0,0 +1,66 @@
+#!/bin/bash
+# ensemble-regime.sh
+#
+# Runs tests/ensemble-regime.params (Newtonian, elastic and relaxation-free
+# cases) as one ensemble process and checks that every case ran in the
+# log-conformation regime of its own De and Ec, as listed in the `regime`
+# column of ensemble-summary.
+#
+# Usage:
+#   bash tests/ensemble-regime.sh [--mode in|out]
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_DIR="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+MODE="in"
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -h|--help)
+      sed -n '2,10p' "${BASH_SOURCE[0]}" | sed 's/^# \{0,1\}//'
+      exit 0
+      ;;
+    --mode) MODE="${2:-}"; shift 2 ;;
+    --mode=*) MODE="${1#*=}"; shift ;;
+    *) echo "ERROR: Unknown argument: $1" >&2; exit 1 ;;
+  esac
+done
+
+PARAM_FILE="${SCRIPT_DIR}/ensemble-regime.params"
+CASE_DIR="${REPO_DIR}/simulationCases/c9001-${MODE}"
+SUMMARY="${CASE_DIR}/ensemble-summary"
+
+# Expected regime per CaseNo.
+declare -A EXPECTED=(
+  [9001]=newtonian
+  [9002]=full
+  [9003]=no-relaxation
+  [9004]=full
+  [9005]=newtonian
+)
+
+# Start from t = 0: a leftover restart would skip the cases.
+rm -rf "$CASE_DIR"
+if ! bash "${REPO_DIR}/runSimulation.sh" "$PARAM_FILE" --mode "$MODE" \
+     > "${SCRIPT_DIR}/ensemble-regime.log" 2>&1; then
+  tail -n 20 "${SCRIPT_DIR}/ensemble-regime.log" >&2
+  echo "FAIL: ensemble run failed (log: tests/ensemble-regime.log)" >&2
+  exit 1
+fi
+
+failed=0
+for case_no in "${!EXPECTED[@]}"; do
+  regime="$(awk -v c="$case_no" '$1 == c && $2 == "ran" { print $8 }' "$SUMMARY")"
+  if [[ "$regime" != "${EXPECTED[$case_no]}" ]]; then
+    echo "FAIL: case ${case_no} ran as '${regime:-missing}'," \
+         "expected '${EXPECTED[$case_no]}'" >&2
+    failed=1
+  fi
+done
+
+if [[ $failed -ne 0 ]]; then
+  cat "$SUMMARY" >&2
+  exit 1
+fi
+echo "PASS: ${#EXPECTED[@]} ensemble cases ran in their own regime"